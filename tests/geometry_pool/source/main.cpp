@@ -0,0 +1,129 @@
+#include <vulkanite/renderer/range_allocator.hpp>
+
+#include <cstdint>
+#include <cstdio>
+#include <stdexcept>
+
+namespace {
+    std::uint32_t failures = 0;
+
+    void check(bool condition, const char* description) {
+        if (!condition) {
+            std::fprintf(stderr, "FAILED: %s\n", description);
+            failures++;
+        }
+    }
+
+    template <typename Function>
+    void checkThrows(Function&& function, const char* description) {
+        try {
+            function();
+        }
+        catch (const std::runtime_error&) {
+            return;
+        }
+
+        std::fprintf(stderr, "FAILED: %s\n", description);
+        failures++;
+    }
+
+    void testAllocate() {
+        vulkanite::renderer::RangeAllocator allocator;
+
+        allocator.create(100);
+
+        auto first = allocator.allocate(30);
+        auto second = allocator.allocate(20);
+
+        check(first == 0u, "first allocation starts at zero");
+        check(second == 30u, "second allocation follows the first");
+        check(allocator.getUsedCount() == 50, "used count covers both allocations");
+        check(allocator.getLargestFreeRange() == 50, "remaining range is the tail");
+
+        check(!allocator.allocate(0), "zero-sized allocation is rejected");
+        check(!allocator.allocate(51), "allocation larger than the free space fails");
+        check(allocator.allocate(50) == 50u, "allocation can fill the remaining space exactly");
+        check(allocator.getFreeRangeCount() == 0, "full allocator has no free ranges");
+        check(!allocator.allocate(1), "full allocator rejects further allocations");
+    }
+
+    void testFreeAndCoalesce() {
+        vulkanite::renderer::RangeAllocator allocator;
+
+        allocator.create(90);
+
+        auto a = allocator.allocate(30).value();
+        auto b = allocator.allocate(30).value();
+        auto c = allocator.allocate(30).value();
+
+        allocator.free(a, 30);
+        allocator.free(c, 30);
+
+        check(allocator.getFreeRangeCount() == 2, "non-adjacent frees stay separate");
+        check(allocator.getLargestFreeRange() == 30, "separate frees are not merged");
+
+        allocator.free(b, 30);
+
+        check(allocator.getFreeRangeCount() == 1, "freeing the middle merges both neighbours");
+        check(allocator.getLargestFreeRange() == 90, "merged range spans the whole capacity");
+        check(allocator.getUsedCount() == 0, "used count returns to zero");
+        check(allocator.allocate(90) == 0u, "coalesced range can be allocated whole");
+    }
+
+    void testBestFit() {
+        vulkanite::renderer::RangeAllocator allocator;
+
+        allocator.create(100);
+
+        auto a = allocator.allocate(40).value();
+        allocator.allocate(10);
+        auto b = allocator.allocate(15).value();
+        allocator.allocate(10);
+
+        allocator.free(a, 40);
+        allocator.free(b, 15);
+
+        check(allocator.allocate(12) == b, "smallest fitting range is chosen");
+        check(allocator.allocate(25) == 75u, "exact fit is preferred over a larger range");
+        check(allocator.allocate(40) == a, "large allocation uses the remaining large range");
+    }
+
+    void testInvalidFree() {
+        vulkanite::renderer::RangeAllocator allocator;
+
+        allocator.create(64);
+
+        auto a = allocator.allocate(16).value();
+
+        checkThrows([&]() { allocator.free(60, 8); }, "range past the capacity is rejected");
+        checkThrows([&]() { allocator.free(0xFFFFFFF0u, 32); }, "wrapping range is rejected");
+        checkThrows([&]() { allocator.free(32, 8); }, "range that is already free is rejected");
+        checkThrows([&]() { allocator.free(8, 16); }, "range overlapping a free range is rejected");
+
+        check(allocator.getUsedCount() == 16, "rejected frees leave the used count intact");
+
+        allocator.free(a, 16);
+
+        checkThrows([&]() { allocator.free(a, 16); }, "double free is rejected");
+        check(allocator.getUsedCount() == 0, "double free does not underflow the used count");
+
+        check(!allocator.isAllocated(0, 0), "empty range is never allocated");
+    }
+}
+
+int main() {
+    testAllocate();
+    testFreeAndCoalesce();
+    testBestFit();
+    testInvalidFree();
+
+    if (failures > 0) {
+        std::fprintf(stderr, "%u check(s) failed\n", failures);
+
+        return 1;
+    }
+
+    std::printf("All geometry pool checks passed\n");
+
+    return 0;
+}
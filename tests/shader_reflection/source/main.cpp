@@ -0,0 +1,263 @@
+#include <vulkanite/renderer/shader_reflection.hpp>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <initializer_list>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+namespace {
+    constexpr std::uint32_t OP_ENTRY_POINT = 15;
+    constexpr std::uint32_t OP_EXECUTION_MODE = 16;
+    constexpr std::uint32_t OP_TYPE_FLOAT = 22;
+    constexpr std::uint32_t OP_TYPE_VECTOR = 23;
+    constexpr std::uint32_t OP_TYPE_STRUCT = 30;
+    constexpr std::uint32_t OP_TYPE_POINTER = 32;
+    constexpr std::uint32_t OP_VARIABLE = 59;
+    constexpr std::uint32_t OP_DECORATE = 71;
+    constexpr std::uint32_t OP_MEMBER_DECORATE = 72;
+
+    constexpr std::uint32_t EXECUTION_MODEL_VERTEX = 0;
+    constexpr std::uint32_t EXECUTION_MODEL_FRAGMENT = 4;
+    constexpr std::uint32_t EXECUTION_MODEL_GL_COMPUTE = 5;
+
+    constexpr std::uint32_t STORAGE_CLASS_INPUT = 1;
+    constexpr std::uint32_t STORAGE_CLASS_UNIFORM = 2;
+    constexpr std::uint32_t STORAGE_CLASS_PUSH_CONSTANT = 9;
+
+    constexpr std::uint32_t DECORATION_BLOCK = 2;
+    constexpr std::uint32_t DECORATION_LOCATION = 30;
+    constexpr std::uint32_t DECORATION_BINDING = 33;
+    constexpr std::uint32_t DECORATION_DESCRIPTOR_SET = 34;
+    constexpr std::uint32_t DECORATION_OFFSET = 35;
+
+    constexpr std::uint32_t EXECUTION_MODE_LOCAL_SIZE = 17;
+
+    struct ModuleBuilder {
+        std::vector<std::uint32_t> words = {0x07230203, 0x00010000, 0, 64, 0};
+
+        void op(std::uint32_t opcode, std::initializer_list<std::uint32_t> operands) {
+            words.push_back(static_cast<std::uint32_t>(operands.size() + 1) << 16 | opcode);
+            words.insert(words.end(), operands.begin(), operands.end());
+        }
+
+        void entryPoint(std::uint32_t model, std::uint32_t id, std::string_view name, std::initializer_list<std::uint32_t> interface) {
+            std::vector<std::uint32_t> nameWords(name.size() / sizeof(std::uint32_t) + 1, 0);
+
+            std::memcpy(nameWords.data(), name.data(), name.size());
+
+            words.push_back(static_cast<std::uint32_t>(3 + nameWords.size() + interface.size()) << 16 | OP_ENTRY_POINT);
+            words.push_back(model);
+            words.push_back(id);
+            words.insert(words.end(), nameWords.begin(), nameWords.end());
+            words.insert(words.end(), interface.begin(), interface.end());
+        }
+    };
+
+    std::uint32_t failures = 0;
+
+    void check(bool condition, const char* description) {
+        if (!condition) {
+            std::fprintf(stderr, "FAILED: %s\n", description);
+            failures++;
+        }
+    }
+
+    template <typename Function>
+    void checkThrows(Function&& function, const char* description) {
+        try {
+            function();
+        }
+        catch (const std::runtime_error&) {
+            return;
+        }
+
+        std::fprintf(stderr, "FAILED: %s\n", description);
+        failures++;
+    }
+
+    // ids: 1 main, 2 float, 3 vec3, 4 vec4, 5 input pointer, 6 position, 7 block struct, 8 uniform pointer,
+    // 9 uniform block, 10 push constant struct, 11 push constant pointer, 12 push constants, 13 unused input
+    ModuleBuilder buildVertexModule() {
+        ModuleBuilder module;
+
+        module.entryPoint(EXECUTION_MODEL_VERTEX, 1, "main", {6});
+
+        module.op(OP_DECORATE, {6, DECORATION_LOCATION, 0});
+        module.op(OP_DECORATE, {13, DECORATION_LOCATION, 1});
+        module.op(OP_DECORATE, {7, DECORATION_BLOCK});
+        module.op(OP_MEMBER_DECORATE, {7, 0, DECORATION_OFFSET, 0});
+        module.op(OP_DECORATE, {9, DECORATION_DESCRIPTOR_SET, 0});
+        module.op(OP_DECORATE, {9, DECORATION_BINDING, 1});
+        module.op(OP_DECORATE, {10, DECORATION_BLOCK});
+        module.op(OP_MEMBER_DECORATE, {10, 0, DECORATION_OFFSET, 0});
+        module.op(OP_MEMBER_DECORATE, {10, 1, DECORATION_OFFSET, 16});
+
+        module.op(OP_TYPE_FLOAT, {2, 32});
+        module.op(OP_TYPE_VECTOR, {3, 2, 3});
+        module.op(OP_TYPE_VECTOR, {4, 2, 4});
+        module.op(OP_TYPE_POINTER, {5, STORAGE_CLASS_INPUT, 3});
+        module.op(OP_VARIABLE, {5, 6, STORAGE_CLASS_INPUT});
+        module.op(OP_VARIABLE, {5, 13, STORAGE_CLASS_INPUT});
+        module.op(OP_TYPE_STRUCT, {7, 4});
+        module.op(OP_TYPE_POINTER, {8, STORAGE_CLASS_UNIFORM, 7});
+        module.op(OP_VARIABLE, {8, 9, STORAGE_CLASS_UNIFORM});
+        module.op(OP_TYPE_STRUCT, {10, 4, 2});
+        module.op(OP_TYPE_POINTER, {11, STORAGE_CLASS_PUSH_CONSTANT, 10});
+        module.op(OP_VARIABLE, {11, 12, STORAGE_CLASS_PUSH_CONSTANT});
+
+        return module;
+    }
+
+    void testVertexModule() {
+        using namespace vulkanite::renderer;
+
+        ModuleBuilder module = buildVertexModule();
+        ShaderReflection reflection = ShaderReflection::reflect(module.words);
+
+        check(reflection.stage == ShaderStage::VERTEX, "vertex stage is reflected");
+        check(reflection.entryPoint == "main", "entry point name is reflected");
+        check(reflection.pushConstantSizeBytes == 20, "push constant size follows member offsets");
+
+        check(reflection.vertexInputs.size() == 1, "only inputs in the entry point interface are reflected");
+        check(!reflection.vertexInputs.empty() && reflection.vertexInputs[0].location == 0, "vertex input location is reflected");
+        check(!reflection.vertexInputs.empty() && reflection.vertexInputs[0].format == VertexAttributeFormat::R32G32B32_FLOAT, "vertex input format is reflected");
+
+        check(reflection.bindings.size() == 1, "uniform block produces a binding");
+
+        if (!reflection.bindings.empty()) {
+            auto& binding = reflection.bindings[0];
+
+            check(binding.type == DescriptorInputType::UNIFORM_BUFFER, "uniform block is a uniform buffer");
+            check(binding.set == 0 && binding.binding == 1, "binding decorations are reflected");
+            check(binding.count == 1, "non-array binding has a count of one");
+            check(binding.stageFlags == DescriptorShaderStageFlags::VERTEX, "binding is visible to the vertex stage");
+        }
+    }
+
+    void testComputeWorkgroupSize() {
+        using namespace vulkanite::renderer;
+
+        ModuleBuilder module;
+
+        module.entryPoint(EXECUTION_MODEL_GL_COMPUTE, 1, "main", {});
+        module.op(OP_EXECUTION_MODE, {1, EXECUTION_MODE_LOCAL_SIZE, 8, 4, 1});
+
+        ShaderReflection reflection = ShaderReflection::reflect(module.words);
+
+        check(reflection.stage == ShaderStage::COMPUTE, "compute stage is reflected");
+        check(reflection.workgroupSize.x == 8 && reflection.workgroupSize.y == 4 && reflection.workgroupSize.z == 1, "local size is reflected");
+    }
+
+    void testEntryPointSelection() {
+        using namespace vulkanite::renderer;
+
+        ModuleBuilder module;
+
+        module.entryPoint(EXECUTION_MODEL_VERTEX, 1, "vertexMain", {});
+        module.entryPoint(EXECUTION_MODEL_FRAGMENT, 2, "fragmentMain", {});
+
+        checkThrows([&]() { ShaderReflection::reflect(module.words); }, "several entry points require a name");
+        checkThrows([&]() { ShaderReflection::reflect(module.words, "missing"); }, "an unknown entry point name is rejected");
+
+        ShaderReflection reflection = ShaderReflection::reflect(module.words, "fragmentMain");
+
+        check(reflection.stage == ShaderStage::FRAGMENT, "named entry point selects its stage");
+        check(reflection.entryPoint == "fragmentMain", "named entry point is reported");
+    }
+
+    void testMalformedModules() {
+        using namespace vulkanite::renderer;
+
+        checkThrows([]() {
+            std::vector<std::uint32_t> words = {0x07230203, 0x00010000, 0, 64, 0};
+
+            ShaderReflection::reflect(words);
+        }, "a module without entry points is rejected");
+
+        checkThrows([]() {
+            std::vector<std::uint32_t> words = {0xDEADBEEF, 0x00010000, 0, 64, 0};
+
+            ShaderReflection::reflect(words);
+        }, "a bad magic number is rejected");
+
+        checkThrows([]() {
+            ModuleBuilder module;
+
+            module.op(OP_ENTRY_POINT, {EXECUTION_MODEL_VERTEX});
+
+            ShaderReflection::reflect(module.words);
+        }, "a truncated entry point is rejected");
+
+        checkThrows([]() {
+            ModuleBuilder module;
+
+            module.op(OP_ENTRY_POINT, {EXECUTION_MODEL_VERTEX, 1, 0x6E69616D});
+
+            ShaderReflection::reflect(module.words);
+        }, "an unterminated entry point name is rejected");
+
+        checkThrows([]() {
+            ModuleBuilder module;
+
+            module.entryPoint(EXECUTION_MODEL_GL_COMPUTE, 1, "main", {});
+            module.op(OP_EXECUTION_MODE, {1, EXECUTION_MODE_LOCAL_SIZE, 8});
+
+            ShaderReflection::reflect(module.words);
+        }, "a truncated local size is rejected");
+
+        checkThrows([]() {
+            ModuleBuilder module;
+
+            module.entryPoint(EXECUTION_MODEL_VERTEX, 1, "main", {});
+            module.op(OP_DECORATE, {6, DECORATION_LOCATION});
+
+            ShaderReflection::reflect(module.words);
+        }, "a location decoration without a literal is rejected");
+
+        checkThrows([]() {
+            ModuleBuilder module;
+
+            module.entryPoint(EXECUTION_MODEL_VERTEX, 1, "main", {});
+            module.op(OP_MEMBER_DECORATE, {7, 0, DECORATION_OFFSET});
+
+            ShaderReflection::reflect(module.words);
+        }, "an offset decoration without a literal is rejected");
+
+        checkThrows([]() {
+            ModuleBuilder module;
+
+            module.entryPoint(EXECUTION_MODEL_VERTEX, 1, "main", {});
+            module.op(OP_VARIABLE, {5, 6, STORAGE_CLASS_INPUT});
+
+            ShaderReflection::reflect(module.words);
+        }, "a variable with an unknown type is rejected");
+
+        checkThrows([]() {
+            ModuleBuilder module = buildVertexModule();
+
+            module.words.resize(module.words.size() - 1);
+
+            ShaderReflection::reflect(module.words);
+        }, "an instruction running past the end of the module is rejected");
+    }
+}
+
+int main() {
+    testVertexModule();
+    testComputeWorkgroupSize();
+    testEntryPointSelection();
+    testMalformedModules();
+
+    if (failures > 0) {
+        std::fprintf(stderr, "%u check(s) failed\n", failures);
+
+        return 1;
+    }
+
+    std::printf("All shader reflection checks passed\n");
+
+    return 0;
+}
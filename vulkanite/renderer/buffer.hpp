@@ -6,6 +6,7 @@
 
 #include "configuration.hpp"
 
+#include <map>
 #include <span>
 
 #include <vk_mem_alloc.h>
@@ -13,6 +14,8 @@
 
 namespace vulkanite::renderer {
     class Device;
+    class MemoryPool;
+    class Queue;
 
     struct BufferCopyRegion {
         std::uint64_t sourceOffsetBytes;
@@ -26,6 +29,16 @@ namespace vulkanite::renderer {
         Flags usageFlags;
 
         std::uint64_t sizeBytes;
+
+        MemoryPool* pool = nullptr;
+
+        bool dedicatedAllocation = false;
+
+        // ignored when allocated from a pool, which applies its own priority
+        float priority = 0.5f;
+
+        // staged buffers rotate through one staging region per frame, so flush writes at most once per frame
+        std::uint32_t framesInFlight = 2;
     };
 
     struct BufferMapping {
@@ -45,7 +58,13 @@ namespace vulkanite::renderer {
         void unmap(BufferMapping& mapping);
 
         std::uint64_t getSize() const;
+        std::uint64_t getDeviceAddress() const;
+        void invalidate(std::uint64_t size, std::uint64_t offset);
+        void flush(std::uint64_t size, std::uint64_t offset);
+
         bool canBeMapped() const;
+        bool isHostCached() const;
+        bool isStaged() const;
 
         explicit operator bool() {
             return buffer_ && allocation_ && device_;
@@ -58,11 +77,57 @@ namespace vulkanite::renderer {
 
         bool isHostCoherent_ = false;
         bool isHostVisible_ = false;
+        bool isHostCached_ = false;
 
         std::uint64_t size_ = 0;
+        std::uint64_t requestedSize_ = 0;
+
+        VkBufferUsageFlags usage_ = 0;
+
+        VkBuffer stagingBuffer_ = nullptr;
+        VmaAllocation stagingAllocation_ = nullptr;
+
+        std::uint64_t stagingStride_ = 0;
+        std::uint32_t stagingRegionCount_ = 0;
+        std::uint32_t stagingRegion_ = 0;
+
+        // written ranges of the current staging region keyed by first byte; only these are uploaded
+        std::map<std::uint64_t, std::uint64_t> pendingWrites_;
+
+        VmaAllocation getMappedAllocation() const;
+        std::uint64_t getMappedOffset() const;
+        void getConsumerScope(VkPipelineStageFlags& stages, VkAccessFlags& access) const;
+        void alignRange(std::uint64_t offset, std::uint64_t size, std::uint64_t& alignedOffset, std::uint64_t& alignedSize) const;
 
         friend class CommandBuffer;
         friend class DescriptorPool;
+        friend class Defragmenter;
+    };
+
+    struct BufferMemoryBarrier {
+        Buffer& buffer;
+        Queue* sourceQueue;
+        Queue* destinationQueue;
+
+        std::uint64_t offsetBytes;
+        std::uint64_t sizeBytes;
+
+        Flags sourceAccessFlags;
+        Flags destinationAccessFlags;
+    };
+
+    struct BufferMemoryBarrier2 {
+        Buffer& buffer;
+        Queue* sourceQueue;
+        Queue* destinationQueue;
+
+        std::uint64_t offsetBytes;
+        std::uint64_t sizeBytes;
+
+        Flags64 sourceStageFlags;
+        Flags64 sourceAccessFlags;
+        Flags64 destinationStageFlags;
+        Flags64 destinationAccessFlags;
     };
 }
 
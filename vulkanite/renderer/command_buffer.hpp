@@ -6,6 +6,7 @@
 
 #include "configuration.hpp"
 
+#include <array>
 #include <cstdint>
 #include <span>
 #include <vector>
@@ -25,23 +26,57 @@ namespace vulkanite::renderer {
     class DescriptorSet;
 
     struct ImageMemoryBarrier;
+    struct ImageMemoryBarrier2;
+    struct BufferMemoryBarrier;
+    struct BufferMemoryBarrier2;
+    struct ImageSubresourceRange;
     struct BufferImageCopyRegion;
     struct BufferCopyRegion;
     struct RenderPassBeginInfo;
+    struct RenderingBeginInfo;
     struct Scissor;
     struct Viewport;
 
+    struct GlobalMemoryBarrier {
+        Flags sourceAccessFlags;
+        Flags destinationAccessFlags;
+    };
+
+    struct GlobalMemoryBarrier2 {
+        Flags64 sourceStageFlags;
+        Flags64 sourceAccessFlags;
+        Flags64 destinationStageFlags;
+        Flags64 destinationAccessFlags;
+    };
+
+    struct DependencyInfo {
+        std::vector<GlobalMemoryBarrier2> memoryBarriers;
+        std::vector<BufferMemoryBarrier2> bufferBarriers;
+        std::vector<ImageMemoryBarrier2> imageBarriers;
+    };
+
     class CommandBuffer {
     public:
         void reset();
         bool beginCapture();
         void beginRenderPass(RenderPassBeginInfo& beginInfo);
+        void beginRendering(const RenderingBeginInfo& beginInfo);
         bool endCapture();
         void endRenderPass();
+        void endRendering();
         void copyBuffer(Buffer& source, Buffer& destination, const std::vector<BufferCopyRegion>& copyRegions);
+        // synchronises against the stages implied by the buffer's usage, so record it on a queue that supports them
+        void flushBufferWrites(Buffer& buffer);
         void copyBufferToImage(Buffer& source, Image& destination, ImageLayout imageLayout, const std::vector<BufferImageCopyRegion>& copyRegions);
         void nextSubpass();
         void pipelineBarrier(Flags sourcePipelineStage, Flags destinationPipelineStage, const std::vector<ImageMemoryBarrier>& memoryBarriers);
+        void pipelineBarrier(Flags sourcePipelineStage, Flags destinationPipelineStage, const std::vector<GlobalMemoryBarrier>& globalBarriers, const std::vector<BufferMemoryBarrier>& bufferBarriers, const std::vector<ImageMemoryBarrier>& imageBarriers);
+        void pipelineBarrier2(const DependencyInfo& dependencyInfo);
+        void requireState(const Image& image, ImageUsage usage);
+        void requireState(const Image& image, ImageUsage usage, const ImageSubresourceRange& range);
+        void assumeState(const Image& image, ImageUsage usage);
+        void assumeState(const Image& image, ImageUsage usage, const ImageSubresourceRange& range);
+        void flushBarriers();
         void bindDescriptorSets(DeviceOperation operation, PipelineLayout& layout, std::uint32_t firstSet, const std::vector<DescriptorSet>& sets);
         void bindPipeline(Pipeline& pipeline);
         void bindVertexBuffers(const std::vector<Buffer>& buffers, const std::vector<std::uint64_t>& offsets, std::uint32_t first);
@@ -55,21 +90,120 @@ namespace vulkanite::renderer {
         void setPipelineStencilCompareMask(Flags faceFlags, std::uint32_t compareMask);
         void setPipelineStencilWriteMask(Flags faceFlags, std::uint32_t writeMask);
         void setPipelineStencilReferenceMask(Flags faceFlags, std::uint32_t reference);
+        void setPipelineCullMode(PolygonCullMode cullMode);
+        void setPipelineFrontFace(PolygonFaceWinding winding);
+        void setPipelinePrimitiveTopology(PolygonTopology topology);
+        void setPipelineDepthTestEnable(bool enable);
+        void setPipelineDepthWriteEnable(bool enable);
+        void setPipelineDepthCompareOperation(CompareOperation comparison);
+        void setPipelineDepthBoundsTestEnable(bool enable);
+        void setPipelineStencilTestEnable(bool enable);
+        void setPipelineStencilOperation(Flags faceFlags, ValueOperation failOperation, ValueOperation passOperation, ValueOperation depthFailOperation, CompareOperation comparison);
+        void setPipelineDepthBiasEnable(bool enable);
+        void setPipelinePrimitiveRestartEnable(bool enable);
+        void setPipelineRasteriserDiscardEnable(bool enable);
+        void setPipelineDepthClampEnable(bool enable);
+        void setPipelineColourBlendEnable(const std::vector<bool>& enables, std::uint32_t firstAttachment);
+        void setPipelineColourWriteMask(const std::vector<Flags>& writeMasks, std::uint32_t firstAttachment);
+        void setPipelineAlphaToCoverageEnable(bool enable);
         void pushConstants(PipelineLayout& layout, std::uint32_t stageFlags, std::span<std::uint8_t> data, std::uint32_t offset);
         void draw(std::uint32_t vertexCount, std::uint32_t instances, std::uint32_t firstVertex, std::uint32_t firstInstance);
         void drawIndexed(std::uint32_t indexCount, std::uint32_t instanceCount, std::uint32_t firstIndex, std::uint32_t firstInstance, std::int32_t vertexOffset);
         bool capturing();
         bool rendering();
+        void setStateFiltering(bool enable);
+        std::uint64_t getRedundantCommandCount() const;
 
     private:
+        enum class TrackedState : std::uint32_t {
+            LINE_WIDTH,
+            DEPTH_BIAS,
+            BLEND_CONSTANTS,
+            DEPTH_BOUNDS,
+            STENCIL_COMPARE_MASK_FRONT,
+            STENCIL_COMPARE_MASK_BACK,
+            STENCIL_WRITE_MASK_FRONT,
+            STENCIL_WRITE_MASK_BACK,
+            STENCIL_REFERENCE_FRONT,
+            STENCIL_REFERENCE_BACK,
+            CULL_MODE,
+            FRONT_FACE,
+            PRIMITIVE_TOPOLOGY,
+            DEPTH_TEST_ENABLE,
+            DEPTH_WRITE_ENABLE,
+            DEPTH_COMPARE_OPERATION,
+            DEPTH_BOUNDS_TEST_ENABLE,
+            STENCIL_TEST_ENABLE,
+            STENCIL_OPERATION_FRONT,
+            STENCIL_OPERATION_BACK,
+            DEPTH_BIAS_ENABLE,
+            PRIMITIVE_RESTART_ENABLE,
+            RASTERISER_DISCARD_ENABLE,
+            DEPTH_CLAMP_ENABLE,
+            ALPHA_TO_COVERAGE_ENABLE,
+            COUNT,
+        };
+
+        struct TrackedValue {
+            std::array<std::uint32_t, 6> data = {};
+
+            bool valid = false;
+        };
+
+        struct VertexBufferBinding {
+            VkBuffer buffer = nullptr;
+
+            std::uint64_t offset = 0;
+        };
+
+        struct IndexBufferBinding {
+            VkBuffer buffer = nullptr;
+            VkIndexType type = VK_INDEX_TYPE_MAX_ENUM;
+
+            std::uint64_t offset = 0;
+        };
+
+        struct DescriptorSetBindings {
+            VkPipelineLayout layout = nullptr;
+
+            std::vector<VkDescriptorSet> sets;
+        };
+
         VkCommandBuffer commandBuffer_ = nullptr;
         CommandPool* commandPool_ = nullptr;
 
         bool capturing_ = false;
         bool rendering_ = false;
+        bool dynamicRendering_ = false;
+        bool filterState_ = false;
+
+        std::uint64_t redundantCommandCount_ = 0;
+
+        std::vector<VkImageMemoryBarrier> pendingImageBarriers_;
+        VkPipelineStageFlags pendingSourceStages_ = 0;
+        VkPipelineStageFlags pendingDestinationStages_ = 0;
+
+        VkPipeline boundPipeline_ = nullptr;
+        IndexBufferBinding boundIndexBuffer_;
+        std::vector<VertexBufferBinding> boundVertexBuffers_;
+        std::array<DescriptorSetBindings, 2> boundDescriptorSets_;
+
+        std::array<TrackedValue, static_cast<std::uint64_t>(TrackedState::COUNT)> trackedStates_;
+        std::vector<TrackedValue> trackedViewports_;
+        std::vector<TrackedValue> trackedScissors_;
+        std::vector<TrackedValue> trackedColourBlendEnables_;
+        std::vector<TrackedValue> trackedColourWriteMasks_;
+
+        void resetTrackedState();
+        bool isRedundant(TrackedState state, const std::array<std::uint32_t, 6>& data);
+        bool isRedundant(Flags faceFlags, TrackedState frontState, TrackedState backState, const std::array<std::uint32_t, 6>& data);
+        bool isRedundant(std::vector<TrackedValue>& tracked, std::uint32_t first, const std::vector<std::array<std::uint32_t, 6>>& data);
+        void requireFeature(Flags feature, const char* function) const;
 
         friend class CommandPool;
         friend class Queue;
+        friend class Defragmenter;
+        friend class FrameGraph;
     };
 }
 
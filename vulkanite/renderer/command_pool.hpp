@@ -33,6 +33,9 @@ namespace vulkanite::renderer {
         VkCommandPool commandPool_ = nullptr;
         Device* device_ = nullptr;
         Queue* queue_ = nullptr;
+
+        friend class Device;
+        friend class CommandBuffer;
     };
 }
 
@@ -10,6 +10,7 @@
 
 namespace vulkanite::renderer {
     using Flags = std::uint32_t;
+    using Flags64 = std::uint64_t;
 
     struct BufferUsageFlags {
         enum {
@@ -20,6 +21,7 @@ namespace vulkanite::renderer {
             STORAGE = 1 << 3,
             TRANSFER_SOURCE = 1 << 4,
             TRANSFER_DESTINATION = 1 << 5,
+            SHADER_DEVICE_ADDRESS = 1 << 6,
         };
 
         static VkFlags mapFrom(Flags flags);
@@ -53,6 +55,7 @@ namespace vulkanite::renderer {
             STORAGE = 1 << 3,
             COLOR_ATTACHMENT = 1 << 4,
             DEPTH_STENCIL_ATTACHMENT = 1 << 5,
+            TRANSIENT_ATTACHMENT = 1 << 6,
         };
 
         static VkFlags mapFrom(Flags flags);
@@ -68,6 +71,22 @@ namespace vulkanite::renderer {
         TRANSFER_DESTINATION_OPTIMAL = 1 << 6,
         GENERAL = 1 << 7,
         PRESENT_SOURCE = 1 << 8,
+        DEPTH_STENCIL_READ_ONLY_OPTIMAL = 1 << 9,
+    };
+
+    enum class ImageUsage {
+        UNDEFINED,
+        TRANSFER_SOURCE,
+        TRANSFER_DESTINATION,
+        COLOUR_ATTACHMENT,
+        DEPTH_STENCIL_ATTACHMENT,
+        DEPTH_STENCIL_READ,
+        VERTEX_SHADER_READ,
+        FRAGMENT_SHADER_READ,
+        COMPUTE_SHADER_READ,
+        COMPUTE_SHADER_WRITE,
+        PRESENT,
+        GENERAL,
     };
 
     struct DescriptorShaderStageFlags {
@@ -75,11 +94,77 @@ namespace vulkanite::renderer {
             NONE = 0,
             VERTEX = 1 << 0,
             FRAGMENT = 1 << 1,
+            COMPUTE = 1 << 2,
+        };
+
+        static VkFlags mapFrom(Flags flags);
+    };
+
+    struct ColourComponentFlags {
+        enum {
+            NONE = 0,
+            R = 1 << 0,
+            G = 1 << 1,
+            B = 1 << 2,
+            A = 1 << 3,
+            ALL = R | G | B | A,
+        };
+
+        static VkFlags mapFrom(Flags flags);
+    };
+
+    struct DeviceFeatureFlags {
+        enum {
+            NONE = 0,
+            EXTENDED_DYNAMIC_STATE = 1 << 0,
+            EXTENDED_DYNAMIC_STATE_2 = 1 << 1,
+            EXTENDED_DYNAMIC_STATE_3 = 1 << 2,
+            GRAPHICS_PIPELINE_LIBRARY = 1 << 3,
+            SYNCHRONISATION_2 = 1 << 4,
+            DYNAMIC_RENDERING = 1 << 5,
+            PRESENT_WAIT = 1 << 6,
+            SWAPCHAIN_MAINTENANCE_1 = 1 << 7,
+            MEMORY_BUDGET = 1 << 8,
+            BUFFER_DEVICE_ADDRESS = 1 << 9,
+            MEMORY_PRIORITY = 1 << 10,
+        };
+    };
+
+    struct PipelineLibraryFlags {
+        enum {
+            NONE = 0,
+            VERTEX_INPUT = 1 << 0,
+            PRE_RASTERISATION = 1 << 1,
+            FRAGMENT_SHADER = 1 << 2,
+            FRAGMENT_OUTPUT = 1 << 3,
+            ALL = VERTEX_INPUT | PRE_RASTERISATION | FRAGMENT_SHADER | FRAGMENT_OUTPUT,
         };
 
         static VkFlags mapFrom(Flags flags);
     };
 
+    struct DynamicStateFlags {
+        enum {
+            NONE = 0,
+            CULL_MODE = 1 << 0,
+            FRONT_FACE = 1 << 1,
+            PRIMITIVE_TOPOLOGY = 1 << 2,
+            DEPTH_TEST_ENABLE = 1 << 3,
+            DEPTH_WRITE_ENABLE = 1 << 4,
+            DEPTH_COMPARE_OPERATION = 1 << 5,
+            DEPTH_BOUNDS_TEST_ENABLE = 1 << 6,
+            STENCIL_TEST_ENABLE = 1 << 7,
+            STENCIL_OPERATION = 1 << 8,
+            DEPTH_BIAS_ENABLE = 1 << 9,
+            PRIMITIVE_RESTART_ENABLE = 1 << 10,
+            RASTERISER_DISCARD_ENABLE = 1 << 11,
+            DEPTH_CLAMP_ENABLE = 1 << 12,
+            COLOUR_BLEND_ENABLE = 1 << 13,
+            COLOUR_WRITE_MASK = 1 << 14,
+            ALPHA_TO_COVERAGE_ENABLE = 1 << 15,
+        };
+    };
+
     struct StencilFaceFlags {
         enum {
             NONE = 0,
@@ -119,11 +204,41 @@ namespace vulkanite::renderer {
             HOST = 1 << 10,
             ALL_GRAPHICS = 1 << 11,
             ALL_COMMANDS = 1 << 12,
+            COMPUTE_SHADER = 1 << 13,
         };
 
         static VkFlags mapFrom(Flags flags);
     };
 
+    struct PipelineStage2Flags {
+        enum : std::uint64_t {
+            NONE = 0,
+            TOP_OF_PIPE = 1ull << 0,
+            DRAW_INDIRECT = 1ull << 1,
+            VERTEX_INPUT = 1ull << 2,
+            VERTEX_SHADER = 1ull << 3,
+            FRAGMENT_SHADER = 1ull << 4,
+            EARLY_FRAGMENT_TESTS = 1ull << 5,
+            LATE_FRAGMENT_TESTS = 1ull << 6,
+            COLOR_ATTACHMENT_OUTPUT = 1ull << 7,
+            COMPUTE_SHADER = 1ull << 8,
+            ALL_TRANSFER = 1ull << 9,
+            BOTTOM_OF_PIPE = 1ull << 10,
+            HOST = 1ull << 11,
+            ALL_GRAPHICS = 1ull << 12,
+            ALL_COMMANDS = 1ull << 13,
+            COPY = 1ull << 14,
+            RESOLVE = 1ull << 15,
+            BLIT = 1ull << 16,
+            CLEAR = 1ull << 17,
+            INDEX_INPUT = 1ull << 18,
+            VERTEX_ATTRIBUTE_INPUT = 1ull << 19,
+            PRE_RASTERISATION_SHADERS = 1ull << 20,
+        };
+
+        static VkFlags64 mapFrom(Flags64 flags);
+    };
+
     struct AccessFlags {
         enum {
             NONE = 0,
@@ -149,9 +264,40 @@ namespace vulkanite::renderer {
         static VkFlags mapFrom(Flags flags);
     };
 
+    struct AccessFlags2 {
+        enum : std::uint64_t {
+            NONE = 0,
+            INDIRECT_COMMAND_READ = 1ull << 0,
+            INDEX_READ = 1ull << 1,
+            VERTEX_ATTRIBUTE_READ = 1ull << 2,
+            UNIFORM_READ = 1ull << 3,
+            INPUT_ATTACHMENT_READ = 1ull << 4,
+            SHADER_READ = 1ull << 5,
+            SHADER_WRITE = 1ull << 6,
+            COLOR_ATTACHMENT_READ = 1ull << 7,
+            COLOR_ATTACHMENT_WRITE = 1ull << 8,
+            DEPTH_STENCIL_ATTACHMENT_READ = 1ull << 9,
+            DEPTH_STENCIL_ATTACHMENT_WRITE = 1ull << 10,
+            TRANSFER_READ = 1ull << 11,
+            TRANSFER_WRITE = 1ull << 12,
+            HOST_READ = 1ull << 13,
+            HOST_WRITE = 1ull << 14,
+            MEMORY_READ = 1ull << 15,
+            MEMORY_WRITE = 1ull << 16,
+            SHADER_SAMPLED_READ = 1ull << 17,
+            SHADER_STORAGE_READ = 1ull << 18,
+            SHADER_STORAGE_WRITE = 1ull << 19,
+        };
+
+        static VkFlags64 mapFrom(Flags64 flags);
+    };
+
     enum class MemoryType {
         HOST_VISIBLE,
         DEVICE_LOCAL,
+        LAZILY_ALLOCATED,
+        DEVICE_LOCAL_HOST_VISIBLE,
+        HOST_CACHED,
     };
 
     enum class Filter {
@@ -330,6 +476,7 @@ namespace vulkanite::renderer {
     enum class ShaderStage {
         VERTEX,
         FRAGMENT,
+        COMPUTE,
     };
 }
 
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "../macros/cppstd.hpp"
+
+#if VULKANITE_SUPPORTED
+
+#include "configuration.hpp"
+#include "image.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <vk_mem_alloc.h>
+#include <vulkan/vulkan.h>
+
+namespace vulkanite::renderer {
+    class Device;
+    class Buffer;
+    class MemoryPool;
+    class CommandBuffer;
+
+    struct DefragmenterCreateInfo {
+        Device& device;
+        MemoryPool* pool = nullptr;
+
+        std::uint64_t maxBytesPerPass = 16 * 1024 * 1024;
+        std::uint32_t maxAllocationsPerPass = 32;
+    };
+
+    using BufferMovedCallback = std::function<void(Buffer& buffer)>;
+    using ImageMovedCallback = std::function<void(Image& image)>;
+
+    class Defragmenter {
+    public:
+        void create(const DefragmenterCreateInfo& createInfo);
+        void destroy();
+
+        void registerBuffer(Buffer& buffer, BufferMovedCallback onMoved = {});
+        void registerImage(Image& image, ImageMovedCallback onMoved = {});
+        void unregisterBuffer(Buffer& buffer);
+        void unregisterImage(Image& image);
+
+        // records the copies for the next pass; completePass() must only be called once they have executed
+        bool recordPass(CommandBuffer& commandBuffer);
+        void completePass();
+
+        bool isRunning() const;
+        bool isPassPending() const;
+        std::uint64_t getBytesMoved() const;
+        std::uint32_t getAllocationsMoved() const;
+
+        explicit operator bool() const {
+            return device_;
+        }
+
+    private:
+        struct TrackedBuffer {
+            Buffer* buffer;
+            BufferMovedCallback onMoved;
+        };
+
+        struct TrackedImage {
+            Image* image;
+            ImageMovedCallback onMoved;
+        };
+
+        struct PendingMove {
+            Buffer* buffer;
+            Image* image;
+
+            VkBuffer newBuffer;
+            VkImage newImage;
+
+            std::shared_ptr<std::vector<Image::SubresourceState>> newStates;
+
+            BufferMovedCallback onBufferMoved;
+            ImageMovedCallback onImageMoved;
+        };
+
+        Device* device_ = nullptr;
+        MemoryPool* pool_ = nullptr;
+
+        std::uint64_t maxBytesPerPass_ = 0;
+        std::uint32_t maxAllocationsPerPass_ = 0;
+
+        VmaDefragmentationContext context_ = nullptr;
+        VmaDefragmentationPassMoveInfo passInfo_ = {};
+
+        bool passPending_ = false;
+
+        std::vector<TrackedBuffer> buffers_;
+        std::vector<TrackedImage> images_;
+        std::vector<PendingMove> pendingMoves_;
+
+        std::uint64_t bytesMoved_ = 0;
+        std::uint32_t allocationsMoved_ = 0;
+
+        bool moveBuffer(const TrackedBuffer& tracked, const VmaDefragmentationMove& move, CommandBuffer& commandBuffer);
+        bool moveImage(const TrackedImage& tracked, const VmaDefragmentationMove& move, CommandBuffer& commandBuffer);
+        void endDefragmentation();
+    };
+}
+
+#include "detail/defragmenter.inl"
+
+#endif
\ No newline at end of file
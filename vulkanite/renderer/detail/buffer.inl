@@ -3,10 +3,16 @@
 #include "../buffer.hpp"
 #include "../device.hpp"
 #include "../instance.hpp"
+#include "../memory_pool.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
 
 inline void vulkanite::renderer::Buffer::create(const BufferCreateInfo& createInfo) {
     VmaMemoryUsage memoryUsage;
     VkMemoryPropertyFlags memoryProperties;
+    VkMemoryPropertyFlags requiredProperties = 0;
 
     switch (createInfo.memoryType) {
         case MemoryType::DEVICE_LOCAL:
@@ -18,17 +24,54 @@ inline void vulkanite::renderer::Buffer::create(const BufferCreateInfo& createIn
             memoryUsage = VMA_MEMORY_USAGE_CPU_TO_GPU;
             memoryProperties = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
             break;
+
+        case MemoryType::LAZILY_ALLOCATED:
+            throw std::runtime_error("Construction failed: renderer::Buffer: Buffers cannot use lazily allocated memory");
+
+        case MemoryType::DEVICE_LOCAL_HOST_VISIBLE:
+            memoryUsage = VMA_MEMORY_USAGE_CPU_TO_GPU;
+            memoryProperties = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT;
+            break;
+
+        case MemoryType::HOST_CACHED:
+            memoryUsage = VMA_MEMORY_USAGE_GPU_TO_CPU;
+            memoryProperties = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_CACHED_BIT;
+            requiredProperties = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT;
+            break;
+    }
+
+    bool needsDeviceAddress = (createInfo.usageFlags & BufferUsageFlags::SHADER_DEVICE_ADDRESS) != 0;
+
+    if (needsDeviceAddress && !(createInfo.device.enabledFeatures_ & DeviceFeatureFlags::BUFFER_DEVICE_ADDRESS)) {
+        throw std::runtime_error("Construction failed: renderer::Buffer: Device addresses require the buffer device address feature");
+    }
+
+    if (createInfo.priority < 0.0f || createInfo.priority > 1.0f) {
+        throw std::runtime_error("Construction failed: renderer::Buffer: Priority must be between 0 and 1");
+    }
+
+    if (createInfo.framesInFlight == 0) {
+        throw std::runtime_error("Construction failed: renderer::Buffer: Frames in flight must be non-zero");
     }
 
+    VmaAllocationCreateFlags allocationFlags = 0;
+
+    if (createInfo.dedicatedAllocation) {
+        allocationFlags |= VMA_ALLOCATION_CREATE_DEDICATED_MEMORY_BIT;
+    }
+
+    bool writesDirectly = createInfo.memoryType == MemoryType::DEVICE_LOCAL_HOST_VISIBLE && createInfo.device.instance_->supportsLargeHostVisibleHeap_;
+    bool needsStaging = createInfo.memoryType == MemoryType::DEVICE_LOCAL_HOST_VISIBLE && !writesDirectly;
+
     VmaAllocationCreateInfo allocationCreateInfo = {
-        .flags = 0,
+        .flags = allocationFlags,
         .usage = memoryUsage,
-        .requiredFlags = 0,
+        .requiredFlags = writesDirectly ? memoryProperties : requiredProperties,
         .preferredFlags = memoryProperties,
         .memoryTypeBits = 0,
-        .pool = nullptr,
+        .pool = createInfo.pool ? createInfo.pool->pool_ : nullptr,
         .pUserData = nullptr,
-        .priority = 0.0,
+        .priority = createInfo.priority,
     };
 
     VkBufferCreateInfo bufferCreateInfo = {
@@ -42,9 +85,70 @@ inline void vulkanite::renderer::Buffer::create(const BufferCreateInfo& createIn
         .pQueueFamilyIndices = nullptr,
     };
 
+    auto useStaging = [&]() {
+        allocationCreateInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
+        allocationCreateInfo.requiredFlags = 0;
+        allocationCreateInfo.preferredFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+        // a pool's memory type was chosen for host-visible access, so the device-local copy must not use it
+        allocationCreateInfo.pool = nullptr;
+        bufferCreateInfo.usage |= VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+        needsStaging = true;
+    };
+
+    if (needsStaging) {
+        useStaging();
+    }
+
     VmaAllocationInfo allocationInfo = {};
 
-    if (vmaCreateBuffer(createInfo.device.allocator_, &bufferCreateInfo, &allocationCreateInfo, &buffer_, &allocation_, &allocationInfo) != VK_SUCCESS) {
+    VkResult result = vmaCreateBuffer(createInfo.device.allocator_, &bufferCreateInfo, &allocationCreateInfo, &buffer_, &allocation_, &allocationInfo);
+
+    // the BAR heap can run out even when it is large, so fall back rather than fail
+    if (result != VK_SUCCESS && writesDirectly) {
+        useStaging();
+
+        result = vmaCreateBuffer(createInfo.device.allocator_, &bufferCreateInfo, &allocationCreateInfo, &buffer_, &allocation_, &allocationInfo);
+    }
+
+    VmaAllocationInfo mappedAllocationInfo = allocationInfo;
+
+    VkDeviceSize atomSize = createInfo.device.instance_->properties_.limits.nonCoherentAtomSize;
+    std::uint64_t stagingStride = (allocationInfo.size + atomSize - 1) & ~(atomSize - 1);
+
+    if (result == VK_SUCCESS && needsStaging) {
+        VmaAllocationCreateInfo stagingAllocationCreateInfo = {
+            .flags = 0,
+            .usage = VMA_MEMORY_USAGE_CPU_ONLY,
+            .requiredFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT,
+            .preferredFlags = VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+            .memoryTypeBits = 0,
+            .pool = nullptr,
+            .pUserData = nullptr,
+            .priority = 0.0,
+        };
+
+        VkBufferCreateInfo stagingBufferCreateInfo = {
+            .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+            .pNext = nullptr,
+            .flags = 0,
+            .size = stagingStride * createInfo.framesInFlight,
+            .usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+            .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+            .queueFamilyIndexCount = 0,
+            .pQueueFamilyIndices = nullptr,
+        };
+
+        result = vmaCreateBuffer(createInfo.device.allocator_, &stagingBufferCreateInfo, &stagingAllocationCreateInfo, &stagingBuffer_, &stagingAllocation_, &mappedAllocationInfo);
+
+        if (result != VK_SUCCESS) {
+            vmaDestroyBuffer(createInfo.device.allocator_, buffer_, allocation_);
+
+            stagingBuffer_ = nullptr;
+            stagingAllocation_ = nullptr;
+        }
+    }
+
+    if (result != VK_SUCCESS) {
         allocation_ = nullptr;
         buffer_ = nullptr;
     }
@@ -54,12 +158,18 @@ inline void vulkanite::renderer::Buffer::create(const BufferCreateInfo& createIn
         auto& instance = device_->instance_;
         auto& properties = instance->memoryProperties_;
 
-        VkMemoryPropertyFlags flags = properties.memoryTypes[allocationInfo.memoryType].propertyFlags;
+        VkMemoryPropertyFlags flags = properties.memoryTypes[mappedAllocationInfo.memoryType].propertyFlags;
 
         isHostCoherent_ = (flags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) != 0;
         isHostVisible_ = (flags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) != 0;
+        isHostCached_ = (flags & VK_MEMORY_PROPERTY_HOST_CACHED_BIT) != 0;
         device_ = &createInfo.device;
         size_ = allocationInfo.size;
+        requestedSize_ = createInfo.sizeBytes;
+        usage_ = bufferCreateInfo.usage;
+        stagingStride_ = stagingBuffer_ ? stagingStride : 0;
+        stagingRegionCount_ = stagingBuffer_ ? createInfo.framesInFlight : 0;
+        stagingRegion_ = 0;
     }
 }
 
@@ -69,6 +179,19 @@ inline void vulkanite::renderer::Buffer::destroy() {
 
         buffer_ = nullptr;
     }
+
+    if (stagingBuffer_) {
+        vmaDestroyBuffer(device_->allocator_, stagingBuffer_, stagingAllocation_);
+
+        stagingBuffer_ = nullptr;
+        stagingAllocation_ = nullptr;
+    }
+
+    stagingStride_ = 0;
+    stagingRegionCount_ = 0;
+    stagingRegion_ = 0;
+
+    pendingWrites_.clear();
 }
 
 inline vulkanite::renderer::BufferMapping vulkanite::renderer::Buffer::map(std::uint64_t size, std::uint64_t offset) {
@@ -76,43 +199,177 @@ inline vulkanite::renderer::BufferMapping vulkanite::renderer::Buffer::map(std::
 
     mapping.offset = offset;
 
-    if (!isHostCoherent_) {
-        auto& instance = device_->instance_;
-        auto& properties = instance->properties_;
+    alignRange(getMappedOffset() + offset, size, mapping.alignedOffset, mapping.alignedSize);
 
-        VkDeviceSize atomSize = properties.limits.nonCoherentAtomSize;
+    void* data = nullptr;
 
-        mapping.alignedOffset = offset & ~(atomSize - 1);
-        mapping.alignedSize = ((mapping.alignedOffset + size + atomSize - 1) & ~(atomSize - 1)) - mapping.alignedOffset;
+    vmaMapMemory(device_->allocator_, getMappedAllocation(), &data);
 
-        vmaInvalidateAllocation(device_->allocator_, allocation_, mapping.alignedOffset, mapping.alignedSize);
-    }
-    else {
-        mapping.alignedOffset = offset;
-        mapping.alignedSize = size;
+    if (!isHostCoherent_) {
+        vmaInvalidateAllocation(device_->allocator_, getMappedAllocation(), mapping.alignedOffset, mapping.alignedSize);
     }
 
-    void* data = nullptr;
-
-    vmaMapMemory(device_->allocator_, allocation_, &data);
-
-    mapping.data = {reinterpret_cast<std::uint8_t*>(data) + offset, size};
+    mapping.data = {reinterpret_cast<std::uint8_t*>(data) + getMappedOffset() + offset, size};
 
     return mapping;
 }
 
 inline void vulkanite::renderer::Buffer::unmap(BufferMapping& mapping) {
     if (!isHostCoherent_) {
-        vmaFlushAllocation(device_->allocator_, allocation_, mapping.alignedOffset, mapping.alignedSize);
+        vmaFlushAllocation(device_->allocator_, getMappedAllocation(), mapping.alignedOffset, mapping.alignedSize);
     }
 
-    vmaUnmapMemory(device_->allocator_, allocation_);
+    vmaUnmapMemory(device_->allocator_, getMappedAllocation());
+
+    if (stagingBuffer_ && !mapping.data.empty()) {
+        std::uint64_t writeBegin = mapping.offset;
+        std::uint64_t writeEnd = mapping.offset + mapping.data.size();
+
+        // merge with touching ranges so each flush copies as few regions as possible
+        auto next = pendingWrites_.upper_bound(writeBegin);
+
+        if (next != pendingWrites_.begin()) {
+            auto previous = std::prev(next);
+
+            if (previous->second >= writeBegin) {
+                writeBegin = previous->first;
+                writeEnd = std::max(writeEnd, previous->second);
+
+                pendingWrites_.erase(previous);
+            }
+        }
+
+        while (next != pendingWrites_.end() && next->first <= writeEnd) {
+            writeEnd = std::max(writeEnd, next->second);
+            next = pendingWrites_.erase(next);
+        }
+
+        pendingWrites_.emplace_hint(next, writeBegin, writeEnd);
+    }
 }
 
 inline std::uint64_t vulkanite::renderer::Buffer::getSize() const {
     return size_;
 }
 
+inline std::uint64_t vulkanite::renderer::Buffer::getDeviceAddress() const {
+    if (!(usage_ & VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT_KHR)) {
+        throw std::runtime_error("Call failed: renderer::Buffer::getDeviceAddress(): Buffer was not created with device address usage");
+    }
+
+    VkBufferDeviceAddressInfoKHR addressInfo = {
+        .sType = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO_KHR,
+        .pNext = nullptr,
+        .buffer = buffer_,
+    };
+
+    return device_->functions_.getBufferDeviceAddress(device_->device_, &addressInfo);
+}
+
 inline bool vulkanite::renderer::Buffer::canBeMapped() const {
     return isHostVisible_;
+}
+
+inline void vulkanite::renderer::Buffer::invalidate(std::uint64_t size, std::uint64_t offset) {
+    if (isHostCoherent_) {
+        return;
+    }
+
+    std::uint64_t alignedOffset = 0;
+    std::uint64_t alignedSize = 0;
+
+    alignRange(getMappedOffset() + offset, size, alignedOffset, alignedSize);
+
+    vmaInvalidateAllocation(device_->allocator_, getMappedAllocation(), alignedOffset, alignedSize);
+}
+
+inline void vulkanite::renderer::Buffer::flush(std::uint64_t size, std::uint64_t offset) {
+    if (isHostCoherent_) {
+        return;
+    }
+
+    std::uint64_t alignedOffset = 0;
+    std::uint64_t alignedSize = 0;
+
+    alignRange(getMappedOffset() + offset, size, alignedOffset, alignedSize);
+
+    vmaFlushAllocation(device_->allocator_, getMappedAllocation(), alignedOffset, alignedSize);
+}
+
+inline bool vulkanite::renderer::Buffer::isHostCached() const {
+    return isHostCached_;
+}
+
+inline bool vulkanite::renderer::Buffer::isStaged() const {
+    return stagingBuffer_ != nullptr;
+}
+
+inline VmaAllocation vulkanite::renderer::Buffer::getMappedAllocation() const {
+    return stagingAllocation_ ? stagingAllocation_ : allocation_;
+}
+
+inline std::uint64_t vulkanite::renderer::Buffer::getMappedOffset() const {
+    return static_cast<std::uint64_t>(stagingRegion_) * stagingStride_;
+}
+
+inline void vulkanite::renderer::Buffer::getConsumerScope(VkPipelineStageFlags& stages, VkAccessFlags& access) const {
+    constexpr VkPipelineStageFlags shaderStages = VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+
+    stages = 0;
+    access = 0;
+
+    if (usage_ & VK_BUFFER_USAGE_VERTEX_BUFFER_BIT) {
+        stages |= VK_PIPELINE_STAGE_VERTEX_INPUT_BIT;
+        access |= VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT;
+    }
+
+    if (usage_ & VK_BUFFER_USAGE_INDEX_BUFFER_BIT) {
+        stages |= VK_PIPELINE_STAGE_VERTEX_INPUT_BIT;
+        access |= VK_ACCESS_INDEX_READ_BIT;
+    }
+
+    if (usage_ & VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT) {
+        stages |= VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT;
+        access |= VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
+    }
+
+    if (usage_ & VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT) {
+        stages |= shaderStages;
+        access |= VK_ACCESS_UNIFORM_READ_BIT;
+    }
+
+    if (usage_ & (VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_UNIFORM_TEXEL_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_TEXEL_BUFFER_BIT)) {
+        stages |= shaderStages;
+        access |= VK_ACCESS_SHADER_READ_BIT;
+    }
+
+    if (usage_ & VK_BUFFER_USAGE_TRANSFER_SRC_BIT) {
+        stages |= VK_PIPELINE_STAGE_TRANSFER_BIT;
+        access |= VK_ACCESS_TRANSFER_READ_BIT;
+    }
+
+    // usages without a known reader fall back to a full barrier
+    if (stages == 0) {
+        stages = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+        access = VK_ACCESS_MEMORY_READ_BIT;
+    }
+}
+
+inline void vulkanite::renderer::Buffer::alignRange(std::uint64_t offset, std::uint64_t size, std::uint64_t& alignedOffset, std::uint64_t& alignedSize) const {
+    if (isHostCoherent_) {
+        alignedOffset = offset;
+        alignedSize = size;
+
+        return;
+    }
+
+    VkDeviceSize atomSize = device_->instance_->properties_.limits.nonCoherentAtomSize;
+
+    // round outwards from the requested range, then clamp so the end never passes the allocation
+    alignedOffset = offset & ~(atomSize - 1);
+
+    std::uint64_t mappedSize = stagingBuffer_ ? stagingStride_ * stagingRegionCount_ : size_;
+    std::uint64_t alignedEnd = std::min((offset + size + atomSize - 1) & ~(atomSize - 1), mappedSize);
+
+    alignedSize = alignedEnd - alignedOffset;
 }
\ No newline at end of file
@@ -10,13 +10,30 @@
 #include "../pipeline.hpp"
 #include "../render_pass.hpp"
 
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+#include <string>
+
 inline void vulkanite::renderer::CommandBuffer::reset() {
     vkResetCommandBuffer(commandBuffer_, 0);
+
+    pendingImageBarriers_.clear();
+    pendingSourceStages_ = 0;
+    pendingDestinationStages_ = 0;
+
+    resetTrackedState();
 }
 
 inline bool vulkanite::renderer::CommandBuffer::beginCapture() {
     capturing_ = true;
 
+    pendingImageBarriers_.clear();
+    pendingSourceStages_ = 0;
+    pendingDestinationStages_ = 0;
+
+    resetTrackedState();
+
     VkCommandBufferBeginInfo commandBufferBeginInfo = {
         .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
         .pNext = nullptr,
@@ -28,6 +45,8 @@ inline bool vulkanite::renderer::CommandBuffer::beginCapture() {
 }
 
 inline void vulkanite::renderer::CommandBuffer::beginRenderPass(RenderPassBeginInfo& beginInfo) {
+    flushBarriers();
+
     rendering_ = true;
 
     std::uint32_t clearValueCount = static_cast<std::uint32_t>(beginInfo.colourClearValues.size());
@@ -85,18 +104,114 @@ inline void vulkanite::renderer::CommandBuffer::beginRenderPass(RenderPassBeginI
     vkCmdBeginRenderPass(commandBuffer_, &renderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
 }
 
+inline void vulkanite::renderer::CommandBuffer::beginRendering(const RenderingBeginInfo& beginInfo) {
+    requireFeature(DeviceFeatureFlags::DYNAMIC_RENDERING, "beginRendering");
+
+    flushBarriers();
+
+    rendering_ = true;
+    dynamicRendering_ = true;
+
+    std::vector<VkRenderingAttachmentInfoKHR> colourAttachments(beginInfo.colourAttachments.size());
+
+    for (std::uint64_t i = 0; i < colourAttachments.size(); i++) {
+        auto& attachment = beginInfo.colourAttachments[i];
+
+        colourAttachments[i] = {
+            .sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR,
+            .pNext = nullptr,
+            .imageView = attachment.imageView.imageView_,
+            .imageLayout = Image::mapLayout(attachment.layout),
+            .resolveMode = VK_RESOLVE_MODE_NONE,
+            .resolveImageView = nullptr,
+            .resolveImageLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+            .loadOp = static_cast<VkAttachmentLoadOp>(attachment.operations.load),
+            .storeOp = static_cast<VkAttachmentStoreOp>(attachment.operations.store),
+            .clearValue = {
+                .color = {
+                    {
+                        attachment.clearValue.r,
+                        attachment.clearValue.g,
+                        attachment.clearValue.b,
+                        attachment.clearValue.a,
+                    },
+                },
+            },
+        };
+    }
+
+    VkRenderingAttachmentInfoKHR depthAttachment = {};
+    VkRenderingAttachmentInfoKHR stencilAttachment = {};
+
+    VkImageAspectFlags depthStencilAspects = 0;
+
+    if (beginInfo.depthStencilAttachment) {
+        auto& attachment = beginInfo.depthStencilAttachment.value();
+
+        depthStencilAspects = Image::getAspectMask(attachment.imageView.format_);
+
+        depthAttachment = {
+            .sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR,
+            .pNext = nullptr,
+            .imageView = attachment.imageView.imageView_,
+            .imageLayout = Image::mapLayout(attachment.layout),
+            .resolveMode = VK_RESOLVE_MODE_NONE,
+            .resolveImageView = nullptr,
+            .resolveImageLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+            .loadOp = static_cast<VkAttachmentLoadOp>(attachment.depthOperations.load),
+            .storeOp = static_cast<VkAttachmentStoreOp>(attachment.depthOperations.store),
+            .clearValue = {
+                .depthStencil = {
+                    .depth = attachment.depthClearValue,
+                    .stencil = attachment.stencilClearValue,
+                },
+            },
+        };
+
+        stencilAttachment = depthAttachment;
+        stencilAttachment.loadOp = static_cast<VkAttachmentLoadOp>(attachment.stencilOperations.load);
+        stencilAttachment.storeOp = static_cast<VkAttachmentStoreOp>(attachment.stencilOperations.store);
+    }
+
+    VkRenderingInfoKHR renderingInfo = {
+        .sType = VK_STRUCTURE_TYPE_RENDERING_INFO_KHR,
+        .pNext = nullptr,
+        .flags = 0,
+        .renderArea = {
+            {
+                beginInfo.region.position.x,
+                beginInfo.region.position.y,
+            },
+            {
+                beginInfo.region.extent.x,
+                beginInfo.region.extent.y,
+            },
+        },
+        .layerCount = beginInfo.layerCount,
+        .viewMask = 0,
+        .colorAttachmentCount = static_cast<std::uint32_t>(colourAttachments.size()),
+        .pColorAttachments = colourAttachments.data(),
+        .pDepthAttachment = (depthStencilAspects & VK_IMAGE_ASPECT_DEPTH_BIT) ? &depthAttachment : nullptr,
+        .pStencilAttachment = (depthStencilAspects & VK_IMAGE_ASPECT_STENCIL_BIT) ? &stencilAttachment : nullptr,
+    };
+
+    commandPool_->device_->functions_.cmdBeginRendering(commandBuffer_, &renderingInfo);
+}
+
 inline bool vulkanite::renderer::CommandBuffer::endCapture() {
     if (!capturing_) {
         return false;
     }
 
+    flushBarriers();
+
     capturing_ = false;
 
     return vkEndCommandBuffer(commandBuffer_) == VK_SUCCESS;
 }
 
 inline void vulkanite::renderer::CommandBuffer::endRenderPass() {
-    if (!rendering_) {
+    if (!rendering_ || dynamicRendering_) {
         return;
     }
 
@@ -105,7 +220,20 @@ inline void vulkanite::renderer::CommandBuffer::endRenderPass() {
     vkCmdEndRenderPass(commandBuffer_);
 }
 
+inline void vulkanite::renderer::CommandBuffer::endRendering() {
+    if (!rendering_ || !dynamicRendering_) {
+        return;
+    }
+
+    rendering_ = false;
+    dynamicRendering_ = false;
+
+    commandPool_->device_->functions_.cmdEndRendering(commandBuffer_);
+}
+
 inline void vulkanite::renderer::CommandBuffer::copyBuffer(Buffer& source, Buffer& destination, const std::vector<BufferCopyRegion>& copyRegions) {
+    flushBarriers();
+
     std::vector<VkBufferCopy> bufferCopies(copyRegions.size());
 
     for (std::uint64_t i = 0; i < bufferCopies.size(); i++) {
@@ -122,7 +250,73 @@ inline void vulkanite::renderer::CommandBuffer::copyBuffer(Buffer& source, Buffe
     vkCmdCopyBuffer(commandBuffer_, source.buffer_, destination.buffer_, static_cast<std::uint32_t>(bufferCopies.size()), bufferCopies.data());
 }
 
+inline void vulkanite::renderer::CommandBuffer::flushBufferWrites(Buffer& buffer) {
+    if (!buffer.stagingBuffer_ || buffer.pendingWrites_.empty()) {
+        return;
+    }
+
+    flushBarriers();
+
+    std::uint64_t begin = buffer.pendingWrites_.begin()->first;
+    std::uint64_t size = buffer.pendingWrites_.rbegin()->second - begin;
+    std::uint64_t stagingOffset = buffer.getMappedOffset();
+
+    VkPipelineStageFlags consumerStages = 0;
+    VkAccessFlags consumerAccess = 0;
+
+    buffer.getConsumerScope(consumerStages, consumerAccess);
+
+    // earlier reads of the destination range must finish before the copy overwrites it
+    VkBufferMemoryBarrier copyBarrier = {
+        .sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER,
+        .pNext = nullptr,
+        .srcAccessMask = 0,
+        .dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+        .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .buffer = buffer.buffer_,
+        .offset = begin,
+        .size = size,
+    };
+
+    vkCmdPipelineBarrier(commandBuffer_, consumerStages, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 1, &copyBarrier, 0, nullptr);
+
+    std::vector<VkBufferCopy> regions;
+
+    regions.reserve(buffer.pendingWrites_.size());
+
+    for (auto& [writeBegin, writeEnd] : buffer.pendingWrites_) {
+        regions.push_back({
+            .srcOffset = stagingOffset + writeBegin,
+            .dstOffset = writeBegin,
+            .size = writeEnd - writeBegin,
+        });
+    }
+
+    vkCmdCopyBuffer(commandBuffer_, buffer.stagingBuffer_, buffer.buffer_, static_cast<std::uint32_t>(regions.size()), regions.data());
+
+    VkBufferMemoryBarrier consumerBarrier = {
+        .sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER,
+        .pNext = nullptr,
+        .srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+        .dstAccessMask = consumerAccess,
+        .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .buffer = buffer.buffer_,
+        .offset = begin,
+        .size = size,
+    };
+
+    vkCmdPipelineBarrier(commandBuffer_, VK_PIPELINE_STAGE_TRANSFER_BIT, consumerStages, 0, 0, nullptr, 1, &consumerBarrier, 0, nullptr);
+
+    // the next frame writes into a region whose previous copy has had framesInFlight frames to complete
+    buffer.pendingWrites_.clear();
+    buffer.stagingRegion_ = (buffer.stagingRegion_ + 1) % buffer.stagingRegionCount_;
+}
+
 inline void vulkanite::renderer::CommandBuffer::copyBufferToImage(Buffer& source, Image& destination, ImageLayout imageLayout, const std::vector<BufferImageCopyRegion>& copyRegions) {
+    flushBarriers();
+
     std::vector<VkBufferImageCopy> copies(copyRegions.size());
 
     for (std::uint64_t i = 0; i < copies.size(); i++) {
@@ -162,6 +356,7 @@ inline void vulkanite::renderer::CommandBuffer::copyBufferToImage(Buffer& source
         {ImageLayout::PREINITIALIZED, VK_IMAGE_LAYOUT_PREINITIALIZED},
         {ImageLayout::COLOR_ATTACHMENT_OPTIMAL, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL},
         {ImageLayout::DEPTH_STENCIL_ATTACHMENT_OPTIMAL, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL},
+        {ImageLayout::DEPTH_STENCIL_READ_ONLY_OPTIMAL, VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL},
         {ImageLayout::SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL},
         {ImageLayout::TRANSFER_SOURCE_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL},
         {ImageLayout::TRANSFER_DESTINATION_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL},
@@ -186,14 +381,47 @@ inline void vulkanite::renderer::CommandBuffer::nextSubpass() {
 }
 
 inline void vulkanite::renderer::CommandBuffer::pipelineBarrier(Flags sourcePipelineStage, Flags destinationPipelineStage, const std::vector<ImageMemoryBarrier>& memoryBarriers) {
-    std::vector<VkImageMemoryBarrier> barriers(memoryBarriers.size());
+    pipelineBarrier(sourcePipelineStage, destinationPipelineStage, {}, {}, memoryBarriers);
+}
+
+inline void vulkanite::renderer::CommandBuffer::pipelineBarrier(Flags sourcePipelineStage, Flags destinationPipelineStage, const std::vector<GlobalMemoryBarrier>& globalBarriers, const std::vector<BufferMemoryBarrier>& bufferBarriers, const std::vector<ImageMemoryBarrier>& imageBarriers) {
+    flushBarriers();
+
+    std::vector<VkMemoryBarrier> vulkanGlobalBarriers(globalBarriers.size());
+    std::vector<VkBufferMemoryBarrier> vulkanBufferBarriers(bufferBarriers.size());
+    std::vector<VkImageMemoryBarrier> barriers(imageBarriers.size());
+
+    for (std::uint64_t i = 0; i < vulkanGlobalBarriers.size(); i++) {
+        vulkanGlobalBarriers[i] = {
+            .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+            .pNext = nullptr,
+            .srcAccessMask = AccessFlags::mapFrom(globalBarriers[i].sourceAccessFlags),
+            .dstAccessMask = AccessFlags::mapFrom(globalBarriers[i].destinationAccessFlags),
+        };
+    }
+
+    for (std::uint64_t i = 0; i < vulkanBufferBarriers.size(); i++) {
+        auto& barrier = bufferBarriers[i];
+
+        vulkanBufferBarriers[i] = {
+            .sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER,
+            .pNext = nullptr,
+            .srcAccessMask = AccessFlags::mapFrom(barrier.sourceAccessFlags),
+            .dstAccessMask = AccessFlags::mapFrom(barrier.destinationAccessFlags),
+            .srcQueueFamilyIndex = barrier.sourceQueue != nullptr ? barrier.sourceQueue->familyIndex_ : VK_QUEUE_FAMILY_IGNORED,
+            .dstQueueFamilyIndex = barrier.destinationQueue != nullptr ? barrier.destinationQueue->familyIndex_ : VK_QUEUE_FAMILY_IGNORED,
+            .buffer = barrier.buffer.buffer_,
+            .offset = barrier.offsetBytes,
+            .size = barrier.sizeBytes,
+        };
+    }
 
     for (std::uint64_t i = 0; i < barriers.size(); i++) {
 
         VkImageLayout oldLayout;
         VkImageLayout newLayout;
 
-        switch (memoryBarriers[i].oldLayout) {
+        switch (imageBarriers[i].oldLayout) {
             case ImageLayout::UNDEFINED:
                 oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
                 break;
@@ -210,6 +438,10 @@ inline void vulkanite::renderer::CommandBuffer::pipelineBarrier(Flags sourcePipe
                 oldLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
                 break;
 
+            case ImageLayout::DEPTH_STENCIL_READ_ONLY_OPTIMAL:
+                oldLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
+                break;
+
             case ImageLayout::SHADER_READ_ONLY_OPTIMAL:
                 oldLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
                 break;
@@ -231,7 +463,7 @@ inline void vulkanite::renderer::CommandBuffer::pipelineBarrier(Flags sourcePipe
                 break;
         }
 
-        switch (memoryBarriers[i].newLayout) {
+        switch (imageBarriers[i].newLayout) {
             case ImageLayout::UNDEFINED:
                 newLayout = VK_IMAGE_LAYOUT_UNDEFINED;
                 break;
@@ -248,6 +480,10 @@ inline void vulkanite::renderer::CommandBuffer::pipelineBarrier(Flags sourcePipe
                 newLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
                 break;
 
+            case ImageLayout::DEPTH_STENCIL_READ_ONLY_OPTIMAL:
+                newLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
+                break;
+
             case ImageLayout::SHADER_READ_ONLY_OPTIMAL:
                 newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
                 break;
@@ -272,24 +508,301 @@ inline void vulkanite::renderer::CommandBuffer::pipelineBarrier(Flags sourcePipe
         barriers[i] = {
             .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
             .pNext = nullptr,
-            .srcAccessMask = AccessFlags::mapFrom(memoryBarriers[i].sourceAccessFlags),
-            .dstAccessMask = AccessFlags::mapFrom(memoryBarriers[i].destinationAccessFlags),
+            .srcAccessMask = AccessFlags::mapFrom(imageBarriers[i].sourceAccessFlags),
+            .dstAccessMask = AccessFlags::mapFrom(imageBarriers[i].destinationAccessFlags),
             .oldLayout = oldLayout,
             .newLayout = newLayout,
-            .srcQueueFamilyIndex = memoryBarriers[i].sourceQueue != nullptr ? memoryBarriers[i].sourceQueue->familyIndex_ : VK_QUEUE_FAMILY_IGNORED,
-            .dstQueueFamilyIndex = memoryBarriers[i].destinationQueue != nullptr ? memoryBarriers[i].destinationQueue->familyIndex_ : VK_QUEUE_FAMILY_IGNORED,
-            .image = memoryBarriers[i].image.image_,
+            .srcQueueFamilyIndex = imageBarriers[i].sourceQueue != nullptr ? imageBarriers[i].sourceQueue->familyIndex_ : VK_QUEUE_FAMILY_IGNORED,
+            .dstQueueFamilyIndex = imageBarriers[i].destinationQueue != nullptr ? imageBarriers[i].destinationQueue->familyIndex_ : VK_QUEUE_FAMILY_IGNORED,
+            .image = imageBarriers[i].image.image_,
             .subresourceRange = {
-                .aspectMask = memoryBarriers[i].aspectMask,
-                .baseMipLevel = memoryBarriers[i].baseMipLevel,
-                .levelCount = memoryBarriers[i].mipLevelCount,
-                .baseArrayLayer = memoryBarriers[i].baseArrayLayer,
-                .layerCount = memoryBarriers[i].arrayLayerCount,
+                .aspectMask = imageBarriers[i].aspectMask,
+                .baseMipLevel = imageBarriers[i].baseMipLevel,
+                .levelCount = imageBarriers[i].mipLevelCount,
+                .baseArrayLayer = imageBarriers[i].baseArrayLayer,
+                .layerCount = imageBarriers[i].arrayLayerCount,
             },
         };
     }
 
-    vkCmdPipelineBarrier(commandBuffer_, PipelineStageFlags::mapFrom(sourcePipelineStage), PipelineStageFlags::mapFrom(destinationPipelineStage), 0, 0, nullptr, 0, nullptr, static_cast<std::uint32_t>(barriers.size()), barriers.data());
+    vkCmdPipelineBarrier(
+        commandBuffer_,
+        PipelineStageFlags::mapFrom(sourcePipelineStage),
+        PipelineStageFlags::mapFrom(destinationPipelineStage),
+        0,
+        static_cast<std::uint32_t>(vulkanGlobalBarriers.size()),
+        vulkanGlobalBarriers.data(),
+        static_cast<std::uint32_t>(vulkanBufferBarriers.size()),
+        vulkanBufferBarriers.data(),
+        static_cast<std::uint32_t>(barriers.size()),
+        barriers.data());
+}
+
+inline void vulkanite::renderer::CommandBuffer::pipelineBarrier2(const DependencyInfo& dependencyInfo) {
+    requireFeature(DeviceFeatureFlags::SYNCHRONISATION_2, "pipelineBarrier2");
+
+    flushBarriers();
+
+    std::vector<VkMemoryBarrier2KHR> globalBarriers(dependencyInfo.memoryBarriers.size());
+    std::vector<VkBufferMemoryBarrier2KHR> bufferBarriers(dependencyInfo.bufferBarriers.size());
+    std::vector<VkImageMemoryBarrier2KHR> imageBarriers(dependencyInfo.imageBarriers.size());
+
+    for (std::uint64_t i = 0; i < globalBarriers.size(); i++) {
+        auto& barrier = dependencyInfo.memoryBarriers[i];
+
+        globalBarriers[i] = {
+            .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2_KHR,
+            .pNext = nullptr,
+            .srcStageMask = PipelineStage2Flags::mapFrom(barrier.sourceStageFlags),
+            .srcAccessMask = AccessFlags2::mapFrom(barrier.sourceAccessFlags),
+            .dstStageMask = PipelineStage2Flags::mapFrom(barrier.destinationStageFlags),
+            .dstAccessMask = AccessFlags2::mapFrom(barrier.destinationAccessFlags),
+        };
+    }
+
+    for (std::uint64_t i = 0; i < bufferBarriers.size(); i++) {
+        auto& barrier = dependencyInfo.bufferBarriers[i];
+
+        bufferBarriers[i] = {
+            .sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2_KHR,
+            .pNext = nullptr,
+            .srcStageMask = PipelineStage2Flags::mapFrom(barrier.sourceStageFlags),
+            .srcAccessMask = AccessFlags2::mapFrom(barrier.sourceAccessFlags),
+            .dstStageMask = PipelineStage2Flags::mapFrom(barrier.destinationStageFlags),
+            .dstAccessMask = AccessFlags2::mapFrom(barrier.destinationAccessFlags),
+            .srcQueueFamilyIndex = barrier.sourceQueue != nullptr ? barrier.sourceQueue->familyIndex_ : VK_QUEUE_FAMILY_IGNORED,
+            .dstQueueFamilyIndex = barrier.destinationQueue != nullptr ? barrier.destinationQueue->familyIndex_ : VK_QUEUE_FAMILY_IGNORED,
+            .buffer = barrier.buffer.buffer_,
+            .offset = barrier.offsetBytes,
+            .size = barrier.sizeBytes,
+        };
+    }
+
+    for (std::uint64_t i = 0; i < imageBarriers.size(); i++) {
+        auto& barrier = dependencyInfo.imageBarriers[i];
+
+        imageBarriers[i] = {
+            .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2_KHR,
+            .pNext = nullptr,
+            .srcStageMask = PipelineStage2Flags::mapFrom(barrier.sourceStageFlags),
+            .srcAccessMask = AccessFlags2::mapFrom(barrier.sourceAccessFlags),
+            .dstStageMask = PipelineStage2Flags::mapFrom(barrier.destinationStageFlags),
+            .dstAccessMask = AccessFlags2::mapFrom(barrier.destinationAccessFlags),
+            .oldLayout = Image::mapLayout(barrier.oldLayout),
+            .newLayout = Image::mapLayout(barrier.newLayout),
+            .srcQueueFamilyIndex = barrier.sourceQueue != nullptr ? barrier.sourceQueue->familyIndex_ : VK_QUEUE_FAMILY_IGNORED,
+            .dstQueueFamilyIndex = barrier.destinationQueue != nullptr ? barrier.destinationQueue->familyIndex_ : VK_QUEUE_FAMILY_IGNORED,
+            .image = barrier.image.image_,
+            .subresourceRange = {
+                .aspectMask = ImageAspectFlags::mapFrom(barrier.aspectMask),
+                .baseMipLevel = barrier.baseMipLevel,
+                .levelCount = barrier.mipLevelCount,
+                .baseArrayLayer = barrier.baseArrayLayer,
+                .layerCount = barrier.arrayLayerCount,
+            },
+        };
+    }
+
+    VkDependencyInfoKHR vulkanDependencyInfo = {
+        .sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO_KHR,
+        .pNext = nullptr,
+        .dependencyFlags = 0,
+        .memoryBarrierCount = static_cast<std::uint32_t>(globalBarriers.size()),
+        .pMemoryBarriers = globalBarriers.data(),
+        .bufferMemoryBarrierCount = static_cast<std::uint32_t>(bufferBarriers.size()),
+        .pBufferMemoryBarriers = bufferBarriers.data(),
+        .imageMemoryBarrierCount = static_cast<std::uint32_t>(imageBarriers.size()),
+        .pImageMemoryBarriers = imageBarriers.data(),
+    };
+
+    commandPool_->device_->functions_.cmdPipelineBarrier2(commandBuffer_, &vulkanDependencyInfo);
+}
+
+inline void vulkanite::renderer::CommandBuffer::requireState(const Image& image, ImageUsage usage) {
+    ImageSubresourceRange range = {
+        .baseMipLevel = 0,
+        .mipLevelCount = image.mipLevels_,
+        .baseArrayLayer = 0,
+        .arrayLayerCount = image.arrayLayers_,
+    };
+
+    requireState(image, usage, range);
+}
+
+inline void vulkanite::renderer::CommandBuffer::requireState(const Image& image, ImageUsage usage, const ImageSubresourceRange& range) {
+    if (!image.subresourceStates_) {
+        throw std::runtime_error("Call failed: renderer::CommandBuffer::requireState(): Image has no tracked state");
+    }
+
+    if (!image.containsRange(range)) {
+        throw std::runtime_error("Call failed: renderer::CommandBuffer::requireState(): Subresource range is outside the image");
+    }
+
+    if (usage == ImageUsage::UNDEFINED) {
+        throw std::runtime_error("Call failed: renderer::CommandBuffer::requireState(): Cannot transition an image to an undefined usage");
+    }
+
+    constexpr VkAccessFlags writeAccess = VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT | VK_ACCESS_TRANSFER_WRITE_BIT | VK_ACCESS_HOST_WRITE_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+
+    auto& states = *image.subresourceStates_;
+    auto target = Image::mapUsage(usage);
+
+    auto stateAt = [&](std::uint32_t mipLevel, std::uint32_t arrayLayer) -> Image::SubresourceState& {
+        return states[static_cast<std::uint64_t>(mipLevel) * image.arrayLayers_ + arrayLayer];
+    };
+
+    auto transition = [&](std::uint32_t baseMipLevel, std::uint32_t mipLevelCount, std::uint32_t baseArrayLayer, std::uint32_t arrayLayerCount) {
+        auto state = stateAt(baseMipLevel, baseArrayLayer);
+
+        bool layoutChanges = state.layout != target.layout;
+        bool writeHazard = (state.access & writeAccess) != 0 || ((target.access & writeAccess) != 0 && state.stages != 0);
+
+        if (!layoutChanges && !writeHazard) {
+            for (std::uint32_t mipLevel = baseMipLevel; mipLevel < baseMipLevel + mipLevelCount; mipLevel++) {
+                for (std::uint32_t arrayLayer = baseArrayLayer; arrayLayer < baseArrayLayer + arrayLayerCount; arrayLayer++) {
+                    auto& subresource = stateAt(mipLevel, arrayLayer);
+
+                    subresource.stages |= target.stages;
+                    subresource.access |= target.access;
+                }
+            }
+
+            return;
+        }
+
+        for (auto& barrier : pendingImageBarriers_) {
+            auto& pendingRange = barrier.subresourceRange;
+
+            bool overlapsMipLevels = pendingRange.baseMipLevel < baseMipLevel + mipLevelCount && baseMipLevel < pendingRange.baseMipLevel + pendingRange.levelCount;
+            bool overlapsArrayLayers = pendingRange.baseArrayLayer < baseArrayLayer + arrayLayerCount && baseArrayLayer < pendingRange.baseArrayLayer + pendingRange.layerCount;
+
+            if (barrier.image == image.image_ && overlapsMipLevels && overlapsArrayLayers) {
+                flushBarriers();
+                break;
+            }
+        }
+
+        pendingSourceStages_ |= state.stages;
+        pendingDestinationStages_ |= target.stages;
+
+        VkAccessFlags sourceAccess = state.access & writeAccess;
+
+        bool merged = false;
+
+        if (!pendingImageBarriers_.empty()) {
+            auto& last = pendingImageBarriers_.back();
+            auto& lastRange = last.subresourceRange;
+
+            bool compatible = last.image == image.image_ && last.oldLayout == state.layout && last.newLayout == target.layout && last.srcAccessMask == sourceAccess && last.dstAccessMask == target.access;
+
+            if (compatible && lastRange.baseMipLevel == baseMipLevel && lastRange.levelCount == mipLevelCount && lastRange.baseArrayLayer + lastRange.layerCount == baseArrayLayer) {
+                lastRange.layerCount += arrayLayerCount;
+                merged = true;
+            }
+        }
+
+        if (!merged) {
+            pendingImageBarriers_.push_back({
+                .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+                .pNext = nullptr,
+                .srcAccessMask = sourceAccess,
+                .dstAccessMask = target.access,
+                .oldLayout = state.layout,
+                .newLayout = target.layout,
+                .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                .image = image.image_,
+                .subresourceRange = {
+                    .aspectMask = Image::getAspectMask(image.format_),
+                    .baseMipLevel = baseMipLevel,
+                    .levelCount = mipLevelCount,
+                    .baseArrayLayer = baseArrayLayer,
+                    .layerCount = arrayLayerCount,
+                },
+            });
+        }
+
+        for (std::uint32_t mipLevel = baseMipLevel; mipLevel < baseMipLevel + mipLevelCount; mipLevel++) {
+            for (std::uint32_t arrayLayer = baseArrayLayer; arrayLayer < baseArrayLayer + arrayLayerCount; arrayLayer++) {
+                stateAt(mipLevel, arrayLayer) = {
+                    .layout = target.layout,
+                    .stages = target.stages,
+                    .access = target.access,
+                };
+            }
+        }
+    };
+
+    auto& first = stateAt(range.baseMipLevel, range.baseArrayLayer);
+
+    bool uniform = true;
+
+    for (std::uint32_t mipLevel = range.baseMipLevel; uniform && mipLevel < range.baseMipLevel + range.mipLevelCount; mipLevel++) {
+        for (std::uint32_t arrayLayer = range.baseArrayLayer; uniform && arrayLayer < range.baseArrayLayer + range.arrayLayerCount; arrayLayer++) {
+            auto& subresource = stateAt(mipLevel, arrayLayer);
+
+            uniform = subresource.layout == first.layout && subresource.stages == first.stages && subresource.access == first.access;
+        }
+    }
+
+    if (uniform) {
+        transition(range.baseMipLevel, range.mipLevelCount, range.baseArrayLayer, range.arrayLayerCount);
+        return;
+    }
+
+    for (std::uint32_t mipLevel = range.baseMipLevel; mipLevel < range.baseMipLevel + range.mipLevelCount; mipLevel++) {
+        for (std::uint32_t arrayLayer = range.baseArrayLayer; arrayLayer < range.baseArrayLayer + range.arrayLayerCount; arrayLayer++) {
+            transition(mipLevel, 1, arrayLayer, 1);
+        }
+    }
+}
+
+inline void vulkanite::renderer::CommandBuffer::assumeState(const Image& image, ImageUsage usage) {
+    ImageSubresourceRange range = {
+        .baseMipLevel = 0,
+        .mipLevelCount = image.mipLevels_,
+        .baseArrayLayer = 0,
+        .arrayLayerCount = image.arrayLayers_,
+    };
+
+    assumeState(image, usage, range);
+}
+
+inline void vulkanite::renderer::CommandBuffer::assumeState(const Image& image, ImageUsage usage, const ImageSubresourceRange& range) {
+    if (!image.subresourceStates_) {
+        throw std::runtime_error("Call failed: renderer::CommandBuffer::assumeState(): Image has no tracked state");
+    }
+
+    if (!image.containsRange(range)) {
+        throw std::runtime_error("Call failed: renderer::CommandBuffer::assumeState(): Subresource range is outside the image");
+    }
+
+    auto& states = *image.subresourceStates_;
+    auto target = Image::mapUsage(usage);
+
+    for (std::uint32_t mipLevel = range.baseMipLevel; mipLevel < range.baseMipLevel + range.mipLevelCount; mipLevel++) {
+        for (std::uint32_t arrayLayer = range.baseArrayLayer; arrayLayer < range.baseArrayLayer + range.arrayLayerCount; arrayLayer++) {
+            states[static_cast<std::uint64_t>(mipLevel) * image.arrayLayers_ + arrayLayer] = {
+                .layout = target.layout,
+                .stages = target.stages,
+                .access = target.access,
+            };
+        }
+    }
+}
+
+inline void vulkanite::renderer::CommandBuffer::flushBarriers() {
+    if (pendingImageBarriers_.empty()) {
+        return;
+    }
+
+    VkPipelineStageFlags sourceStages = pendingSourceStages_ != 0 ? pendingSourceStages_ : VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+
+    vkCmdPipelineBarrier(commandBuffer_, sourceStages, pendingDestinationStages_, 0, 0, nullptr, 0, nullptr, static_cast<std::uint32_t>(pendingImageBarriers_.size()), pendingImageBarriers_.data());
+
+    pendingImageBarriers_.clear();
+    pendingSourceStages_ = 0;
+    pendingDestinationStages_ = 0;
 }
 
 inline void vulkanite::renderer::CommandBuffer::bindDescriptorSets(DeviceOperation operation, PipelineLayout& layout, std::uint32_t firstSet, const std::vector<DescriptorSet>& sets) {
@@ -311,10 +824,82 @@ inline void vulkanite::renderer::CommandBuffer::bindDescriptorSets(DeviceOperati
         vkSets[i] = sets[i].descriptorSet_;
     }
 
+    if (filterState_) {
+        auto& bound = boundDescriptorSets_[operation == DeviceOperation::GRAPHICS ? 0 : 1];
+
+        bool redundant = bound.layout == layout.pipelineLayout_ && bound.sets.size() >= firstSet + vkSets.size();
+
+        for (std::uint64_t i = 0; redundant && i < vkSets.size(); i++) {
+            redundant = bound.sets[firstSet + i] == vkSets[i];
+        }
+
+        if (redundant) {
+            redundantCommandCount_++;
+            return;
+        }
+
+        if (bound.layout != layout.pipelineLayout_) {
+            bound.layout = layout.pipelineLayout_;
+            bound.sets.clear();
+        }
+
+        if (bound.sets.size() < firstSet + vkSets.size()) {
+            bound.sets.resize(firstSet + vkSets.size(), nullptr);
+        }
+
+        std::copy(vkSets.begin(), vkSets.end(), bound.sets.begin() + firstSet);
+    }
+
     vkCmdBindDescriptorSets(commandBuffer_, point, layout.pipelineLayout_, firstSet, static_cast<std::uint32_t>(vkSets.size()), vkSets.data(), 0, nullptr);
 }
 
 inline void vulkanite::renderer::CommandBuffer::bindPipeline(Pipeline& pipeline) {
+    if (filterState_) {
+        if (boundPipeline_ == pipeline.pipeline_) {
+            redundantCommandCount_++;
+            return;
+        }
+
+        struct StateMap {
+            Flags flag;
+            TrackedState state;
+        };
+
+        constexpr StateMap stateMapping[] = {
+            {DynamicStateFlags::CULL_MODE, TrackedState::CULL_MODE},
+            {DynamicStateFlags::FRONT_FACE, TrackedState::FRONT_FACE},
+            {DynamicStateFlags::PRIMITIVE_TOPOLOGY, TrackedState::PRIMITIVE_TOPOLOGY},
+            {DynamicStateFlags::DEPTH_TEST_ENABLE, TrackedState::DEPTH_TEST_ENABLE},
+            {DynamicStateFlags::DEPTH_WRITE_ENABLE, TrackedState::DEPTH_WRITE_ENABLE},
+            {DynamicStateFlags::DEPTH_COMPARE_OPERATION, TrackedState::DEPTH_COMPARE_OPERATION},
+            {DynamicStateFlags::DEPTH_BOUNDS_TEST_ENABLE, TrackedState::DEPTH_BOUNDS_TEST_ENABLE},
+            {DynamicStateFlags::STENCIL_TEST_ENABLE, TrackedState::STENCIL_TEST_ENABLE},
+            {DynamicStateFlags::STENCIL_OPERATION, TrackedState::STENCIL_OPERATION_FRONT},
+            {DynamicStateFlags::STENCIL_OPERATION, TrackedState::STENCIL_OPERATION_BACK},
+            {DynamicStateFlags::DEPTH_BIAS_ENABLE, TrackedState::DEPTH_BIAS_ENABLE},
+            {DynamicStateFlags::PRIMITIVE_RESTART_ENABLE, TrackedState::PRIMITIVE_RESTART_ENABLE},
+            {DynamicStateFlags::RASTERISER_DISCARD_ENABLE, TrackedState::RASTERISER_DISCARD_ENABLE},
+            {DynamicStateFlags::DEPTH_CLAMP_ENABLE, TrackedState::DEPTH_CLAMP_ENABLE},
+            {DynamicStateFlags::ALPHA_TO_COVERAGE_ENABLE, TrackedState::ALPHA_TO_COVERAGE_ENABLE},
+        };
+
+        for (auto& mapping : stateMapping) {
+            if (!(pipeline.dynamicStateFlags_ & mapping.flag)) {
+                trackedStates_[static_cast<std::uint64_t>(mapping.state)].valid = false;
+            }
+        }
+
+        if (!(pipeline.dynamicStateFlags_ & DynamicStateFlags::COLOUR_BLEND_ENABLE)) {
+            trackedColourBlendEnables_.clear();
+        }
+
+        if (!(pipeline.dynamicStateFlags_ & DynamicStateFlags::COLOUR_WRITE_MASK)) {
+            trackedColourWriteMasks_.clear();
+        }
+
+        boundPipeline_ = pipeline.pipeline_;
+    }
+
     vkCmdBindPipeline(commandBuffer_, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline.pipeline_);
 }
 
@@ -325,6 +910,32 @@ inline void vulkanite::renderer::CommandBuffer::bindVertexBuffers(const std::vec
         vulkanBuffers[i] = buffers[i].buffer_;
     }
 
+    if (filterState_) {
+        bool redundant = boundVertexBuffers_.size() >= first + vulkanBuffers.size();
+
+        for (std::uint64_t i = 0; redundant && i < vulkanBuffers.size(); i++) {
+            auto& bound = boundVertexBuffers_[first + i];
+
+            redundant = bound.buffer == vulkanBuffers[i] && bound.offset == offsets[i];
+        }
+
+        if (redundant) {
+            redundantCommandCount_++;
+            return;
+        }
+
+        if (boundVertexBuffers_.size() < first + vulkanBuffers.size()) {
+            boundVertexBuffers_.resize(first + vulkanBuffers.size());
+        }
+
+        for (std::uint64_t i = 0; i < vulkanBuffers.size(); i++) {
+            boundVertexBuffers_[first + i] = {
+                .buffer = vulkanBuffers[i],
+                .offset = offsets[i],
+            };
+        }
+    }
+
     vkCmdBindVertexBuffers(commandBuffer_, first, static_cast<std::uint32_t>(vulkanBuffers.size()), vulkanBuffers.data(), offsets.data());
 }
 
@@ -341,10 +952,44 @@ inline void vulkanite::renderer::CommandBuffer::bindIndexBuffer(Buffer& buffer,
             break;
     }
 
+    if (filterState_) {
+        if (boundIndexBuffer_.buffer == buffer.buffer_ && boundIndexBuffer_.offset == offset && boundIndexBuffer_.type == type) {
+            redundantCommandCount_++;
+            return;
+        }
+
+        boundIndexBuffer_ = {
+            .buffer = buffer.buffer_,
+            .type = type,
+            .offset = offset,
+        };
+    }
+
     vkCmdBindIndexBuffer(commandBuffer_, buffer.buffer_, offset, type);
 }
 
 inline void vulkanite::renderer::CommandBuffer::setPipelineViewports(const std::vector<renderer::Viewport>& viewports, std::uint32_t offset) {
+    if (filterState_) {
+        std::vector<std::array<std::uint32_t, 6>> values(viewports.size());
+
+        for (std::uint64_t i = 0; i < values.size(); i++) {
+            auto& viewport = viewports[i];
+
+            values[i] = {
+                std::bit_cast<std::uint32_t>(viewport.position.x),
+                std::bit_cast<std::uint32_t>(viewport.position.y),
+                std::bit_cast<std::uint32_t>(viewport.extent.x),
+                std::bit_cast<std::uint32_t>(viewport.extent.y),
+                std::bit_cast<std::uint32_t>(viewport.minDepth),
+                std::bit_cast<std::uint32_t>(viewport.maxDepth),
+            };
+        }
+
+        if (isRedundant(trackedViewports_, offset, values)) {
+            return;
+        }
+    }
+
     std::vector<VkViewport> vulkanViewports(viewports.size());
 
     for (std::uint32_t i = 0; i < vulkanViewports.size(); i++) {
@@ -365,6 +1010,25 @@ inline void vulkanite::renderer::CommandBuffer::setPipelineViewports(const std::
 }
 
 inline void vulkanite::renderer::CommandBuffer::setPipelineScissors(const std::vector<renderer::Scissor>& scissors, std::uint32_t offset) {
+    if (filterState_) {
+        std::vector<std::array<std::uint32_t, 6>> values(scissors.size());
+
+        for (std::uint64_t i = 0; i < values.size(); i++) {
+            auto& scissor = scissors[i];
+
+            values[i] = {
+                static_cast<std::uint32_t>(scissor.offset.x),
+                static_cast<std::uint32_t>(scissor.offset.y),
+                scissor.extent.x,
+                scissor.extent.y,
+            };
+        }
+
+        if (isRedundant(trackedScissors_, offset, values)) {
+            return;
+        }
+    }
+
     std::vector<VkRect2D> vulkanScissors(scissors.size());
 
     for (std::uint32_t i = 0; i < vulkanScissors.size(); i++) {
@@ -382,44 +1046,258 @@ inline void vulkanite::renderer::CommandBuffer::setPipelineScissors(const std::v
 }
 
 inline void vulkanite::renderer::CommandBuffer::setPipelineLineWidth(float width) {
+    if (isRedundant(TrackedState::LINE_WIDTH, {std::bit_cast<std::uint32_t>(width)})) {
+        return;
+    }
+
     vkCmdSetLineWidth(commandBuffer_, width);
 }
 
 inline void vulkanite::renderer::CommandBuffer::setPipelineDepthBias(float depthBiasConstantFactor, float depthBiasClamp, float depthBiasSlopeFactor) {
+    if (isRedundant(TrackedState::DEPTH_BIAS, {std::bit_cast<std::uint32_t>(depthBiasConstantFactor), std::bit_cast<std::uint32_t>(depthBiasClamp), std::bit_cast<std::uint32_t>(depthBiasSlopeFactor)})) {
+        return;
+    }
+
     vkCmdSetDepthBias(commandBuffer_, depthBiasConstantFactor, depthBiasClamp, depthBiasSlopeFactor);
 }
 
 inline void vulkanite::renderer::CommandBuffer::setPipelineBlendConstants(const glm::fvec4& blend) {
+    if (isRedundant(TrackedState::BLEND_CONSTANTS, {std::bit_cast<std::uint32_t>(blend.r), std::bit_cast<std::uint32_t>(blend.g), std::bit_cast<std::uint32_t>(blend.b), std::bit_cast<std::uint32_t>(blend.a)})) {
+        return;
+    }
+
     vkCmdSetBlendConstants(commandBuffer_, &blend.r);
 }
 
 inline void vulkanite::renderer::CommandBuffer::setPipelineDepthBounds(float min, float max) {
+    if (isRedundant(TrackedState::DEPTH_BOUNDS, {std::bit_cast<std::uint32_t>(min), std::bit_cast<std::uint32_t>(max)})) {
+        return;
+    }
+
     vkCmdSetDepthBounds(commandBuffer_, min, max);
 }
 
 inline void vulkanite::renderer::CommandBuffer::setPipelineStencilCompareMask(Flags faceFlags, std::uint32_t compareMask) {
+    if (isRedundant(faceFlags, TrackedState::STENCIL_COMPARE_MASK_FRONT, TrackedState::STENCIL_COMPARE_MASK_BACK, {compareMask})) {
+        return;
+    }
+
     vkCmdSetStencilCompareMask(commandBuffer_, StencilFaceFlags::mapFrom(faceFlags), compareMask);
 }
 
 inline void vulkanite::renderer::CommandBuffer::setPipelineStencilWriteMask(Flags faceFlags, std::uint32_t writeMask) {
+    if (isRedundant(faceFlags, TrackedState::STENCIL_WRITE_MASK_FRONT, TrackedState::STENCIL_WRITE_MASK_BACK, {writeMask})) {
+        return;
+    }
+
     vkCmdSetStencilWriteMask(commandBuffer_, StencilFaceFlags::mapFrom(faceFlags), writeMask);
 }
 
 inline void vulkanite::renderer::CommandBuffer::setPipelineStencilReferenceMask(Flags faceFlags, std::uint32_t reference) {
+    if (isRedundant(faceFlags, TrackedState::STENCIL_REFERENCE_FRONT, TrackedState::STENCIL_REFERENCE_BACK, {reference})) {
+        return;
+    }
+
     vkCmdSetStencilReference(commandBuffer_, StencilFaceFlags::mapFrom(faceFlags), reference);
 }
 
-inline void vulkanite::renderer::CommandBuffer::pushConstants(PipelineLayout& layout, std::uint32_t stageFlags, std::span<std::uint8_t> data, std::uint32_t offset) {
-    VkShaderStageFlags flags = 0;
+inline void vulkanite::renderer::CommandBuffer::setPipelineCullMode(PolygonCullMode cullMode) {
+    requireFeature(DeviceFeatureFlags::EXTENDED_DYNAMIC_STATE, "setPipelineCullMode");
+
+    if (isRedundant(TrackedState::CULL_MODE, {static_cast<std::uint32_t>(cullMode)})) {
+        return;
+    }
+
+    commandPool_->device_->functions_.cmdSetCullMode(commandBuffer_, Pipeline::reverseMapCullMode(cullMode));
+}
+
+inline void vulkanite::renderer::CommandBuffer::setPipelineFrontFace(PolygonFaceWinding winding) {
+    requireFeature(DeviceFeatureFlags::EXTENDED_DYNAMIC_STATE, "setPipelineFrontFace");
+
+    if (isRedundant(TrackedState::FRONT_FACE, {static_cast<std::uint32_t>(winding)})) {
+        return;
+    }
 
-    if (stageFlags & DescriptorShaderStageFlags::VERTEX) {
-        flags |= VK_SHADER_STAGE_VERTEX_BIT;
+    commandPool_->device_->functions_.cmdSetFrontFace(commandBuffer_, Pipeline::reverseMapFrontFace(winding));
+}
+
+inline void vulkanite::renderer::CommandBuffer::setPipelinePrimitiveTopology(PolygonTopology topology) {
+    requireFeature(DeviceFeatureFlags::EXTENDED_DYNAMIC_STATE, "setPipelinePrimitiveTopology");
+
+    if (isRedundant(TrackedState::PRIMITIVE_TOPOLOGY, {static_cast<std::uint32_t>(topology)})) {
+        return;
+    }
+
+    commandPool_->device_->functions_.cmdSetPrimitiveTopology(commandBuffer_, Pipeline::reverseMapPrimitive(topology));
+}
+
+inline void vulkanite::renderer::CommandBuffer::setPipelineDepthTestEnable(bool enable) {
+    requireFeature(DeviceFeatureFlags::EXTENDED_DYNAMIC_STATE, "setPipelineDepthTestEnable");
+
+    if (isRedundant(TrackedState::DEPTH_TEST_ENABLE, {enable})) {
+        return;
+    }
+
+    commandPool_->device_->functions_.cmdSetDepthTestEnable(commandBuffer_, enable ? VK_TRUE : VK_FALSE);
+}
+
+inline void vulkanite::renderer::CommandBuffer::setPipelineDepthWriteEnable(bool enable) {
+    requireFeature(DeviceFeatureFlags::EXTENDED_DYNAMIC_STATE, "setPipelineDepthWriteEnable");
+
+    if (isRedundant(TrackedState::DEPTH_WRITE_ENABLE, {enable})) {
+        return;
+    }
+
+    commandPool_->device_->functions_.cmdSetDepthWriteEnable(commandBuffer_, enable ? VK_TRUE : VK_FALSE);
+}
+
+inline void vulkanite::renderer::CommandBuffer::setPipelineDepthCompareOperation(CompareOperation comparison) {
+    requireFeature(DeviceFeatureFlags::EXTENDED_DYNAMIC_STATE, "setPipelineDepthCompareOperation");
+
+    if (isRedundant(TrackedState::DEPTH_COMPARE_OPERATION, {static_cast<std::uint32_t>(comparison)})) {
+        return;
+    }
+
+    commandPool_->device_->functions_.cmdSetDepthCompareOp(commandBuffer_, Pipeline::reverseMapCompareOperation(comparison));
+}
+
+inline void vulkanite::renderer::CommandBuffer::setPipelineDepthBoundsTestEnable(bool enable) {
+    requireFeature(DeviceFeatureFlags::EXTENDED_DYNAMIC_STATE, "setPipelineDepthBoundsTestEnable");
+
+    if (isRedundant(TrackedState::DEPTH_BOUNDS_TEST_ENABLE, {enable})) {
+        return;
+    }
+
+    commandPool_->device_->functions_.cmdSetDepthBoundsTestEnable(commandBuffer_, enable ? VK_TRUE : VK_FALSE);
+}
+
+inline void vulkanite::renderer::CommandBuffer::setPipelineStencilTestEnable(bool enable) {
+    requireFeature(DeviceFeatureFlags::EXTENDED_DYNAMIC_STATE, "setPipelineStencilTestEnable");
+
+    if (isRedundant(TrackedState::STENCIL_TEST_ENABLE, {enable})) {
+        return;
     }
 
-    if (stageFlags & DescriptorShaderStageFlags::FRAGMENT) {
-        flags |= VK_SHADER_STAGE_FRAGMENT_BIT;
+    commandPool_->device_->functions_.cmdSetStencilTestEnable(commandBuffer_, enable ? VK_TRUE : VK_FALSE);
+}
+
+inline void vulkanite::renderer::CommandBuffer::setPipelineStencilOperation(Flags faceFlags, ValueOperation failOperation, ValueOperation passOperation, ValueOperation depthFailOperation, CompareOperation comparison) {
+    requireFeature(DeviceFeatureFlags::EXTENDED_DYNAMIC_STATE, "setPipelineStencilOperation");
+
+    if (isRedundant(faceFlags, TrackedState::STENCIL_OPERATION_FRONT, TrackedState::STENCIL_OPERATION_BACK, {static_cast<std::uint32_t>(failOperation), static_cast<std::uint32_t>(passOperation), static_cast<std::uint32_t>(depthFailOperation), static_cast<std::uint32_t>(comparison)})) {
+        return;
     }
 
+    commandPool_->device_->functions_.cmdSetStencilOp(
+        commandBuffer_,
+        StencilFaceFlags::mapFrom(faceFlags),
+        Pipeline::reverseMapStencilOperation(failOperation),
+        Pipeline::reverseMapStencilOperation(passOperation),
+        Pipeline::reverseMapStencilOperation(depthFailOperation),
+        Pipeline::reverseMapCompareOperation(comparison));
+}
+
+inline void vulkanite::renderer::CommandBuffer::setPipelineDepthBiasEnable(bool enable) {
+    requireFeature(DeviceFeatureFlags::EXTENDED_DYNAMIC_STATE_2, "setPipelineDepthBiasEnable");
+
+    if (isRedundant(TrackedState::DEPTH_BIAS_ENABLE, {enable})) {
+        return;
+    }
+
+    commandPool_->device_->functions_.cmdSetDepthBiasEnable(commandBuffer_, enable ? VK_TRUE : VK_FALSE);
+}
+
+inline void vulkanite::renderer::CommandBuffer::setPipelinePrimitiveRestartEnable(bool enable) {
+    requireFeature(DeviceFeatureFlags::EXTENDED_DYNAMIC_STATE_2, "setPipelinePrimitiveRestartEnable");
+
+    if (isRedundant(TrackedState::PRIMITIVE_RESTART_ENABLE, {enable})) {
+        return;
+    }
+
+    commandPool_->device_->functions_.cmdSetPrimitiveRestartEnable(commandBuffer_, enable ? VK_TRUE : VK_FALSE);
+}
+
+inline void vulkanite::renderer::CommandBuffer::setPipelineRasteriserDiscardEnable(bool enable) {
+    requireFeature(DeviceFeatureFlags::EXTENDED_DYNAMIC_STATE_2, "setPipelineRasteriserDiscardEnable");
+
+    if (isRedundant(TrackedState::RASTERISER_DISCARD_ENABLE, {enable})) {
+        return;
+    }
+
+    commandPool_->device_->functions_.cmdSetRasterizerDiscardEnable(commandBuffer_, enable ? VK_TRUE : VK_FALSE);
+}
+
+inline void vulkanite::renderer::CommandBuffer::setPipelineDepthClampEnable(bool enable) {
+    requireFeature(DeviceFeatureFlags::EXTENDED_DYNAMIC_STATE_3, "setPipelineDepthClampEnable");
+
+    if (isRedundant(TrackedState::DEPTH_CLAMP_ENABLE, {enable})) {
+        return;
+    }
+
+    commandPool_->device_->functions_.cmdSetDepthClampEnable(commandBuffer_, enable ? VK_TRUE : VK_FALSE);
+}
+
+inline void vulkanite::renderer::CommandBuffer::setPipelineColourBlendEnable(const std::vector<bool>& enables, std::uint32_t firstAttachment) {
+    requireFeature(DeviceFeatureFlags::EXTENDED_DYNAMIC_STATE_3, "setPipelineColourBlendEnable");
+
+    std::vector<VkBool32> vulkanEnables(enables.size());
+
+    for (std::uint64_t i = 0; i < vulkanEnables.size(); i++) {
+        vulkanEnables[i] = enables[i] ? VK_TRUE : VK_FALSE;
+    }
+
+    if (filterState_) {
+        std::vector<std::array<std::uint32_t, 6>> values(vulkanEnables.size());
+
+        for (std::uint64_t i = 0; i < values.size(); i++) {
+            values[i] = {vulkanEnables[i]};
+        }
+
+        if (isRedundant(trackedColourBlendEnables_, firstAttachment, values)) {
+            return;
+        }
+    }
+
+    commandPool_->device_->functions_.cmdSetColorBlendEnable(commandBuffer_, firstAttachment, static_cast<std::uint32_t>(vulkanEnables.size()), vulkanEnables.data());
+}
+
+inline void vulkanite::renderer::CommandBuffer::setPipelineColourWriteMask(const std::vector<Flags>& writeMasks, std::uint32_t firstAttachment) {
+    requireFeature(DeviceFeatureFlags::EXTENDED_DYNAMIC_STATE_3, "setPipelineColourWriteMask");
+
+    std::vector<VkColorComponentFlags> vulkanMasks(writeMasks.size());
+
+    for (std::uint64_t i = 0; i < vulkanMasks.size(); i++) {
+        vulkanMasks[i] = ColourComponentFlags::mapFrom(writeMasks[i]);
+    }
+
+    if (filterState_) {
+        std::vector<std::array<std::uint32_t, 6>> values(vulkanMasks.size());
+
+        for (std::uint64_t i = 0; i < values.size(); i++) {
+            values[i] = {vulkanMasks[i]};
+        }
+
+        if (isRedundant(trackedColourWriteMasks_, firstAttachment, values)) {
+            return;
+        }
+    }
+
+    commandPool_->device_->functions_.cmdSetColorWriteMask(commandBuffer_, firstAttachment, static_cast<std::uint32_t>(vulkanMasks.size()), vulkanMasks.data());
+}
+
+inline void vulkanite::renderer::CommandBuffer::setPipelineAlphaToCoverageEnable(bool enable) {
+    requireFeature(DeviceFeatureFlags::EXTENDED_DYNAMIC_STATE_3, "setPipelineAlphaToCoverageEnable");
+
+    if (isRedundant(TrackedState::ALPHA_TO_COVERAGE_ENABLE, {enable})) {
+        return;
+    }
+
+    commandPool_->device_->functions_.cmdSetAlphaToCoverageEnable(commandBuffer_, enable ? VK_TRUE : VK_FALSE);
+}
+
+inline void vulkanite::renderer::CommandBuffer::pushConstants(PipelineLayout& layout, std::uint32_t stageFlags, std::span<std::uint8_t> data, std::uint32_t offset) {
+    VkShaderStageFlags flags = DescriptorShaderStageFlags::mapFrom(stageFlags);
+
     vkCmdPushConstants(commandBuffer_, layout.pipelineLayout_, flags, offset, static_cast<std::uint32_t>(data.size()), data.data());
 }
 
@@ -437,4 +1315,144 @@ inline bool vulkanite::renderer::CommandBuffer::capturing() {
 
 inline bool vulkanite::renderer::CommandBuffer::rendering() {
     return rendering_;
+}
+
+inline void vulkanite::renderer::CommandBuffer::setStateFiltering(bool enable) {
+    filterState_ = enable;
+
+    resetTrackedState();
+}
+
+inline std::uint64_t vulkanite::renderer::CommandBuffer::getRedundantCommandCount() const {
+    return redundantCommandCount_;
+}
+
+inline void vulkanite::renderer::CommandBuffer::resetTrackedState() {
+    boundPipeline_ = nullptr;
+    boundIndexBuffer_ = {};
+    boundVertexBuffers_.clear();
+
+    for (auto& bound : boundDescriptorSets_) {
+        bound.layout = nullptr;
+        bound.sets.clear();
+    }
+
+    trackedStates_ = {};
+    trackedViewports_.clear();
+    trackedScissors_.clear();
+    trackedColourBlendEnables_.clear();
+    trackedColourWriteMasks_.clear();
+}
+
+inline bool vulkanite::renderer::CommandBuffer::isRedundant(TrackedState state, const std::array<std::uint32_t, 6>& data) {
+    if (!filterState_) {
+        return false;
+    }
+
+    auto& tracked = trackedStates_[static_cast<std::uint64_t>(state)];
+
+    if (tracked.valid && tracked.data == data) {
+        redundantCommandCount_++;
+        return true;
+    }
+
+    tracked = {
+        .data = data,
+        .valid = true,
+    };
+
+    return false;
+}
+
+inline bool vulkanite::renderer::CommandBuffer::isRedundant(Flags faceFlags, TrackedState frontState, TrackedState backState, const std::array<std::uint32_t, 6>& data) {
+    if (!filterState_) {
+        return false;
+    }
+
+    auto& front = trackedStates_[static_cast<std::uint64_t>(frontState)];
+    auto& back = trackedStates_[static_cast<std::uint64_t>(backState)];
+
+    bool frontMatches = !(faceFlags & StencilFaceFlags::FRONT) || (front.valid && front.data == data);
+    bool backMatches = !(faceFlags & StencilFaceFlags::BACK) || (back.valid && back.data == data);
+
+    if (frontMatches && backMatches) {
+        redundantCommandCount_++;
+        return true;
+    }
+
+    if (faceFlags & StencilFaceFlags::FRONT) {
+        front = {
+            .data = data,
+            .valid = true,
+        };
+    }
+
+    if (faceFlags & StencilFaceFlags::BACK) {
+        back = {
+            .data = data,
+            .valid = true,
+        };
+    }
+
+    return false;
+}
+
+inline bool vulkanite::renderer::CommandBuffer::isRedundant(std::vector<TrackedValue>& tracked, std::uint32_t first, const std::vector<std::array<std::uint32_t, 6>>& data) {
+    if (tracked.size() < first + data.size()) {
+        tracked.resize(first + data.size());
+    }
+
+    bool redundant = true;
+
+    for (std::uint64_t i = 0; redundant && i < data.size(); i++) {
+        auto& value = tracked[first + i];
+
+        redundant = value.valid && value.data == data[i];
+    }
+
+    if (redundant) {
+        redundantCommandCount_++;
+        return true;
+    }
+
+    for (std::uint64_t i = 0; i < data.size(); i++) {
+        tracked[first + i] = {
+            .data = data[i],
+            .valid = true,
+        };
+    }
+
+    return false;
+}
+
+inline void vulkanite::renderer::CommandBuffer::requireFeature(Flags feature, const char* function) const {
+    if (commandPool_->device_->enabledFeatures_ & feature) {
+        return;
+    }
+
+    const char* featureName = "Requested";
+
+    switch (feature) {
+        case DeviceFeatureFlags::EXTENDED_DYNAMIC_STATE:
+            featureName = "Extended dynamic state";
+            break;
+
+        case DeviceFeatureFlags::EXTENDED_DYNAMIC_STATE_2:
+            featureName = "Extended dynamic state 2";
+            break;
+
+        case DeviceFeatureFlags::EXTENDED_DYNAMIC_STATE_3:
+            featureName = "Extended dynamic state 3";
+            break;
+
+        case DeviceFeatureFlags::SYNCHRONISATION_2:
+            featureName = "Synchronisation 2";
+            break;
+
+        case DeviceFeatureFlags::DYNAMIC_RENDERING:
+            featureName = "Dynamic rendering";
+            break;
+    }
+
+    throw std::runtime_error(std::string("Call failed: renderer::CommandBuffer::") + function + "(): " + featureName + " feature is not enabled");
 }
\ No newline at end of file
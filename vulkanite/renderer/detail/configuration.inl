@@ -16,6 +16,7 @@ namespace vulkanite::renderer {
             {BufferUsageFlags::TRANSFER_DESTINATION, VK_BUFFER_USAGE_TRANSFER_DST_BIT},
             {BufferUsageFlags::TRANSFER_SOURCE, VK_BUFFER_USAGE_TRANSFER_SRC_BIT},
             {BufferUsageFlags::UNIFORM, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT},
+            {BufferUsageFlags::SHADER_DEVICE_ADDRESS, VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT_KHR},
         };
 
         VkFlags vkFlags = 0;
@@ -52,6 +53,77 @@ namespace vulkanite::renderer {
         return vkFlags;
     }
 
+    inline VkFlags DescriptorShaderStageFlags::mapFrom(Flags flags) {
+        struct FlagMap {
+            uint32_t flag;
+            VkFlags vkFlag;
+        };
+
+        constexpr FlagMap flagMapping[] = {
+            {DescriptorShaderStageFlags::VERTEX, VK_SHADER_STAGE_VERTEX_BIT},
+            {DescriptorShaderStageFlags::FRAGMENT, VK_SHADER_STAGE_FRAGMENT_BIT},
+            {DescriptorShaderStageFlags::COMPUTE, VK_SHADER_STAGE_COMPUTE_BIT},
+        };
+
+        VkFlags vkFlags = 0;
+
+        for (auto& flag : flagMapping) {
+            if (flags & flag.flag) {
+                vkFlags |= flag.vkFlag;
+            }
+        }
+
+        return vkFlags;
+    }
+
+    inline VkFlags ColourComponentFlags::mapFrom(Flags flags) {
+        struct FlagMap {
+            uint32_t flag;
+            VkFlags vkFlag;
+        };
+
+        constexpr FlagMap flagMapping[] = {
+            {ColourComponentFlags::R, VK_COLOR_COMPONENT_R_BIT},
+            {ColourComponentFlags::G, VK_COLOR_COMPONENT_G_BIT},
+            {ColourComponentFlags::B, VK_COLOR_COMPONENT_B_BIT},
+            {ColourComponentFlags::A, VK_COLOR_COMPONENT_A_BIT},
+        };
+
+        VkFlags vkFlags = 0;
+
+        for (auto& flag : flagMapping) {
+            if (flags & flag.flag) {
+                vkFlags |= flag.vkFlag;
+            }
+        }
+
+        return vkFlags;
+    }
+
+    inline VkFlags PipelineLibraryFlags::mapFrom(Flags flags) {
+        struct FlagMap {
+            uint32_t flag;
+            VkFlags vkFlag;
+        };
+
+        constexpr FlagMap flagMapping[] = {
+            {PipelineLibraryFlags::VERTEX_INPUT, VK_GRAPHICS_PIPELINE_LIBRARY_VERTEX_INPUT_INTERFACE_BIT_EXT},
+            {PipelineLibraryFlags::PRE_RASTERISATION, VK_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION_SHADERS_BIT_EXT},
+            {PipelineLibraryFlags::FRAGMENT_SHADER, VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER_BIT_EXT},
+            {PipelineLibraryFlags::FRAGMENT_OUTPUT, VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_OUTPUT_INTERFACE_BIT_EXT},
+        };
+
+        VkFlags vkFlags = 0;
+
+        for (auto& flag : flagMapping) {
+            if (flags & flag.flag) {
+                vkFlags |= flag.vkFlag;
+            }
+        }
+
+        return vkFlags;
+    }
+
     inline VkFlags ImageAspectFlags::mapFrom(Flags flags) {
         struct FlagMap {
             uint32_t flag;
@@ -146,6 +218,7 @@ namespace vulkanite::renderer {
             {ImageUsageFlags::STORAGE, VK_IMAGE_USAGE_STORAGE_BIT},
             {ImageUsageFlags::TRANSFER_DESTINATION, VK_IMAGE_USAGE_TRANSFER_DST_BIT},
             {ImageUsageFlags::TRANSFER_SOURCE, VK_IMAGE_USAGE_TRANSFER_SRC_BIT},
+            {ImageUsageFlags::TRANSIENT_ATTACHMENT, VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT},
         };
 
         VkFlags vkFlags = 0;
@@ -159,6 +232,87 @@ namespace vulkanite::renderer {
         return vkFlags;
     }
 
+    inline VkFlags64 PipelineStage2Flags::mapFrom(Flags64 flags) {
+        struct FlagMap {
+            uint64_t flag;
+            VkFlags64 vkFlag;
+        };
+
+        constexpr FlagMap flagMapping[] = {
+            {PipelineStage2Flags::TOP_OF_PIPE, VK_PIPELINE_STAGE_2_TOP_OF_PIPE_BIT},
+            {PipelineStage2Flags::DRAW_INDIRECT, VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT},
+            {PipelineStage2Flags::VERTEX_INPUT, VK_PIPELINE_STAGE_2_VERTEX_INPUT_BIT},
+            {PipelineStage2Flags::VERTEX_SHADER, VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT},
+            {PipelineStage2Flags::FRAGMENT_SHADER, VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT},
+            {PipelineStage2Flags::EARLY_FRAGMENT_TESTS, VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT},
+            {PipelineStage2Flags::LATE_FRAGMENT_TESTS, VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT},
+            {PipelineStage2Flags::COLOR_ATTACHMENT_OUTPUT, VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT},
+            {PipelineStage2Flags::COMPUTE_SHADER, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT},
+            {PipelineStage2Flags::ALL_TRANSFER, VK_PIPELINE_STAGE_2_ALL_TRANSFER_BIT},
+            {PipelineStage2Flags::BOTTOM_OF_PIPE, VK_PIPELINE_STAGE_2_BOTTOM_OF_PIPE_BIT},
+            {PipelineStage2Flags::HOST, VK_PIPELINE_STAGE_2_HOST_BIT},
+            {PipelineStage2Flags::ALL_GRAPHICS, VK_PIPELINE_STAGE_2_ALL_GRAPHICS_BIT},
+            {PipelineStage2Flags::ALL_COMMANDS, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT},
+            {PipelineStage2Flags::COPY, VK_PIPELINE_STAGE_2_COPY_BIT},
+            {PipelineStage2Flags::RESOLVE, VK_PIPELINE_STAGE_2_RESOLVE_BIT},
+            {PipelineStage2Flags::BLIT, VK_PIPELINE_STAGE_2_BLIT_BIT},
+            {PipelineStage2Flags::CLEAR, VK_PIPELINE_STAGE_2_CLEAR_BIT},
+            {PipelineStage2Flags::INDEX_INPUT, VK_PIPELINE_STAGE_2_INDEX_INPUT_BIT},
+            {PipelineStage2Flags::VERTEX_ATTRIBUTE_INPUT, VK_PIPELINE_STAGE_2_VERTEX_ATTRIBUTE_INPUT_BIT},
+            {PipelineStage2Flags::PRE_RASTERISATION_SHADERS, VK_PIPELINE_STAGE_2_PRE_RASTERIZATION_SHADERS_BIT},
+        };
+
+        VkFlags64 vkFlags = 0;
+
+        for (auto& flag : flagMapping) {
+            if (flags & flag.flag) {
+                vkFlags |= flag.vkFlag;
+            }
+        }
+
+        return vkFlags;
+    }
+
+    inline VkFlags64 AccessFlags2::mapFrom(Flags64 flags) {
+        struct FlagMap {
+            uint64_t flag;
+            VkFlags64 vkFlag;
+        };
+
+        constexpr FlagMap flagMapping[] = {
+            {AccessFlags2::INDIRECT_COMMAND_READ, VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT},
+            {AccessFlags2::INDEX_READ, VK_ACCESS_2_INDEX_READ_BIT},
+            {AccessFlags2::VERTEX_ATTRIBUTE_READ, VK_ACCESS_2_VERTEX_ATTRIBUTE_READ_BIT},
+            {AccessFlags2::UNIFORM_READ, VK_ACCESS_2_UNIFORM_READ_BIT},
+            {AccessFlags2::INPUT_ATTACHMENT_READ, VK_ACCESS_2_INPUT_ATTACHMENT_READ_BIT},
+            {AccessFlags2::SHADER_READ, VK_ACCESS_2_SHADER_READ_BIT},
+            {AccessFlags2::SHADER_WRITE, VK_ACCESS_2_SHADER_WRITE_BIT},
+            {AccessFlags2::COLOR_ATTACHMENT_READ, VK_ACCESS_2_COLOR_ATTACHMENT_READ_BIT},
+            {AccessFlags2::COLOR_ATTACHMENT_WRITE, VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT},
+            {AccessFlags2::DEPTH_STENCIL_ATTACHMENT_READ, VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT},
+            {AccessFlags2::DEPTH_STENCIL_ATTACHMENT_WRITE, VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT},
+            {AccessFlags2::TRANSFER_READ, VK_ACCESS_2_TRANSFER_READ_BIT},
+            {AccessFlags2::TRANSFER_WRITE, VK_ACCESS_2_TRANSFER_WRITE_BIT},
+            {AccessFlags2::HOST_READ, VK_ACCESS_2_HOST_READ_BIT},
+            {AccessFlags2::HOST_WRITE, VK_ACCESS_2_HOST_WRITE_BIT},
+            {AccessFlags2::MEMORY_READ, VK_ACCESS_2_MEMORY_READ_BIT},
+            {AccessFlags2::MEMORY_WRITE, VK_ACCESS_2_MEMORY_WRITE_BIT},
+            {AccessFlags2::SHADER_SAMPLED_READ, VK_ACCESS_2_SHADER_SAMPLED_READ_BIT},
+            {AccessFlags2::SHADER_STORAGE_READ, VK_ACCESS_2_SHADER_STORAGE_READ_BIT},
+            {AccessFlags2::SHADER_STORAGE_WRITE, VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT},
+        };
+
+        VkFlags64 vkFlags = 0;
+
+        for (auto& flag : flagMapping) {
+            if (flags & flag.flag) {
+                vkFlags |= flag.vkFlag;
+            }
+        }
+
+        return vkFlags;
+    }
+
     inline VkFlags PipelineStageFlags::mapFrom(Flags flags) {
         struct FlagMap {
             uint32_t flag;
@@ -179,6 +333,7 @@ namespace vulkanite::renderer {
             {PipelineStageFlags::HOST, VK_PIPELINE_STAGE_HOST_BIT},
             {PipelineStageFlags::ALL_GRAPHICS, VK_PIPELINE_STAGE_ALL_GRAPHICS_BIT},
             {PipelineStageFlags::ALL_COMMANDS, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT},
+            {PipelineStageFlags::COMPUTE_SHADER, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT},
         };
 
         VkFlags vkFlags = 0;
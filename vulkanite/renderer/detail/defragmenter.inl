@@ -0,0 +1,403 @@
+#pragma once
+
+#include "../buffer.hpp"
+#include "../command_buffer.hpp"
+#include "../defragmenter.hpp"
+#include "../device.hpp"
+#include "../image.hpp"
+#include "../memory_pool.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+inline void vulkanite::renderer::Defragmenter::create(const DefragmenterCreateInfo& createInfo) {
+    if (createInfo.maxBytesPerPass == 0 || createInfo.maxAllocationsPerPass == 0) {
+        throw std::runtime_error("Construction failed: renderer::Defragmenter: Per-pass budgets must be non-zero");
+    }
+
+    device_ = &createInfo.device;
+    pool_ = createInfo.pool;
+    maxBytesPerPass_ = createInfo.maxBytesPerPass;
+    maxAllocationsPerPass_ = createInfo.maxAllocationsPerPass;
+}
+
+inline void vulkanite::renderer::Defragmenter::destroy() {
+    if (passPending_) {
+        for (auto& move : pendingMoves_) {
+            if (move.buffer) {
+                vkDestroyBuffer(device_->device_, move.newBuffer, nullptr);
+            }
+            else {
+                vkDestroyImage(device_->device_, move.newImage, nullptr);
+            }
+        }
+
+        for (std::uint64_t i = 0; i < passInfo_.moveCount; i++) {
+            passInfo_.pMoves[i].operation = VMA_DEFRAGMENTATION_MOVE_OPERATION_IGNORE;
+        }
+
+        vmaEndDefragmentationPass(device_->allocator_, context_, &passInfo_);
+
+        pendingMoves_.clear();
+        passPending_ = false;
+    }
+
+    if (context_) {
+        endDefragmentation();
+    }
+
+    buffers_.clear();
+    images_.clear();
+
+    device_ = nullptr;
+    pool_ = nullptr;
+    bytesMoved_ = 0;
+    allocationsMoved_ = 0;
+}
+
+inline void vulkanite::renderer::Defragmenter::registerBuffer(Buffer& buffer, BufferMovedCallback onMoved) {
+    buffers_.push_back({
+        .buffer = &buffer,
+        .onMoved = std::move(onMoved),
+    });
+}
+
+inline void vulkanite::renderer::Defragmenter::registerImage(Image& image, ImageMovedCallback onMoved) {
+    images_.push_back({
+        .image = &image,
+        .onMoved = std::move(onMoved),
+    });
+}
+
+inline void vulkanite::renderer::Defragmenter::unregisterBuffer(Buffer& buffer) {
+    bool moving = std::any_of(pendingMoves_.begin(), pendingMoves_.end(), [&](const PendingMove& move) {
+        return move.buffer == &buffer;
+    });
+
+    if (moving) {
+        throw std::runtime_error("Call failed: renderer::Defragmenter::unregisterBuffer(): Buffer is being moved by the pending pass");
+    }
+
+    std::erase_if(buffers_, [&](const TrackedBuffer& tracked) {
+        return tracked.buffer == &buffer;
+    });
+}
+
+inline void vulkanite::renderer::Defragmenter::unregisterImage(Image& image) {
+    bool moving = std::any_of(pendingMoves_.begin(), pendingMoves_.end(), [&](const PendingMove& move) {
+        return move.image == &image;
+    });
+
+    if (moving) {
+        throw std::runtime_error("Call failed: renderer::Defragmenter::unregisterImage(): Image is being moved by the pending pass");
+    }
+
+    std::erase_if(images_, [&](const TrackedImage& tracked) {
+        return tracked.image == &image;
+    });
+}
+
+inline bool vulkanite::renderer::Defragmenter::recordPass(CommandBuffer& commandBuffer) {
+    if (passPending_) {
+        throw std::runtime_error("Call failed: renderer::Defragmenter::recordPass(): Previous pass has not been completed");
+    }
+
+    if (!context_) {
+        VmaDefragmentationInfo defragmentationInfo = {
+            .flags = 0,
+            .pool = pool_ ? pool_->pool_ : nullptr,
+            .maxBytesPerPass = maxBytesPerPass_,
+            .maxAllocationsPerPass = maxAllocationsPerPass_,
+            .pfnBreakCallback = nullptr,
+            .pBreakCallbackUserData = nullptr,
+        };
+
+        if (vmaBeginDefragmentation(device_->allocator_, &defragmentationInfo, &context_) != VK_SUCCESS) {
+            context_ = nullptr;
+
+            throw std::runtime_error("Call failed: renderer::Defragmenter::recordPass(): Failed to begin defragmentation");
+        }
+    }
+
+    VkResult result = vmaBeginDefragmentationPass(device_->allocator_, context_, &passInfo_);
+
+    if (result == VK_SUCCESS) {
+        endDefragmentation();
+
+        return false;
+    }
+
+    if (result != VK_INCOMPLETE) {
+        endDefragmentation();
+
+        throw std::runtime_error("Call failed: renderer::Defragmenter::recordPass(): Failed to begin defragmentation pass");
+    }
+
+    passPending_ = true;
+
+    commandBuffer.flushBarriers();
+
+    VkMemoryBarrier beforeCopies = {
+        .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+        .pNext = nullptr,
+        .srcAccessMask = VK_ACCESS_MEMORY_WRITE_BIT,
+        .dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT,
+    };
+
+    vkCmdPipelineBarrier(commandBuffer.commandBuffer_, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 1, &beforeCopies, 0, nullptr, 0, nullptr);
+
+    for (std::uint64_t i = 0; i < passInfo_.moveCount; i++) {
+        auto& move = passInfo_.pMoves[i];
+
+        auto buffer = std::find_if(buffers_.begin(), buffers_.end(), [&](const TrackedBuffer& tracked) {
+            return tracked.buffer->buffer_ && tracked.buffer->allocation_ == move.srcAllocation;
+        });
+
+        auto image = std::find_if(images_.begin(), images_.end(), [&](const TrackedImage& tracked) {
+            return tracked.image->image_ && tracked.image->allocation_ == move.srcAllocation;
+        });
+
+        bool moved = false;
+
+        if (buffer != buffers_.end()) {
+            moved = moveBuffer(*buffer, move, commandBuffer);
+        }
+        else if (image != images_.end()) {
+            moved = moveImage(*image, move, commandBuffer);
+        }
+
+        // allocations we cannot patch the owner of must stay where they are
+        if (!moved) {
+            move.operation = VMA_DEFRAGMENTATION_MOVE_OPERATION_IGNORE;
+        }
+    }
+
+    VkMemoryBarrier afterCopies = {
+        .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+        .pNext = nullptr,
+        .srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+        .dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT,
+    };
+
+    vkCmdPipelineBarrier(commandBuffer.commandBuffer_, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 1, &afterCopies, 0, nullptr, 0, nullptr);
+
+    return true;
+}
+
+inline void vulkanite::renderer::Defragmenter::completePass() {
+    if (!passPending_) {
+        return;
+    }
+
+    for (auto& move : pendingMoves_) {
+        if (move.buffer) {
+            vkDestroyBuffer(device_->device_, move.buffer->buffer_, nullptr);
+
+            move.buffer->buffer_ = move.newBuffer;
+        }
+        else {
+            vkDestroyImage(device_->device_, move.image->image_, nullptr);
+
+            move.image->image_ = move.newImage;
+            move.image->subresourceStates_ = move.newStates;
+        }
+    }
+
+    VkResult result = vmaEndDefragmentationPass(device_->allocator_, context_, &passInfo_);
+
+    passPending_ = false;
+
+    std::vector<PendingMove> completedMoves = std::move(pendingMoves_);
+
+    pendingMoves_.clear();
+
+    if (result != VK_INCOMPLETE) {
+        endDefragmentation();
+    }
+
+    // views and descriptor sets still reference the old handles, so owners rebuild them here
+    for (auto& move : completedMoves) {
+        if (move.buffer && move.onBufferMoved) {
+            move.onBufferMoved(*move.buffer);
+        }
+        else if (move.image && move.onImageMoved) {
+            move.onImageMoved(*move.image);
+        }
+    }
+}
+
+inline bool vulkanite::renderer::Defragmenter::isRunning() const {
+    return context_ != nullptr;
+}
+
+inline bool vulkanite::renderer::Defragmenter::isPassPending() const {
+    return passPending_;
+}
+
+inline std::uint64_t vulkanite::renderer::Defragmenter::getBytesMoved() const {
+    return bytesMoved_;
+}
+
+inline std::uint32_t vulkanite::renderer::Defragmenter::getAllocationsMoved() const {
+    return allocationsMoved_;
+}
+
+inline bool vulkanite::renderer::Defragmenter::moveBuffer(const TrackedBuffer& tracked, const VmaDefragmentationMove& move, CommandBuffer& commandBuffer) {
+    constexpr VkBufferUsageFlags transferUsage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+
+    Buffer& buffer = *tracked.buffer;
+
+    if ((buffer.usage_ & transferUsage) != transferUsage) {
+        return false;
+    }
+
+    VkBufferCreateInfo bufferCreateInfo = {
+        .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+        .pNext = nullptr,
+        .flags = 0,
+        .size = buffer.requestedSize_,
+        .usage = buffer.usage_,
+        .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+        .queueFamilyIndexCount = 0,
+        .pQueueFamilyIndices = nullptr,
+    };
+
+    VkBuffer newBuffer = nullptr;
+
+    if (vkCreateBuffer(device_->device_, &bufferCreateInfo, nullptr, &newBuffer) != VK_SUCCESS) {
+        return false;
+    }
+
+    if (vmaBindBufferMemory(device_->allocator_, move.dstTmpAllocation, newBuffer) != VK_SUCCESS) {
+        vkDestroyBuffer(device_->device_, newBuffer, nullptr);
+
+        return false;
+    }
+
+    VkBufferCopy region = {
+        .srcOffset = 0,
+        .dstOffset = 0,
+        .size = buffer.requestedSize_,
+    };
+
+    vkCmdCopyBuffer(commandBuffer.commandBuffer_, buffer.buffer_, newBuffer, 1, &region);
+
+    pendingMoves_.push_back({
+        .buffer = &buffer,
+        .image = nullptr,
+        .newBuffer = newBuffer,
+        .newImage = nullptr,
+        .newStates = nullptr,
+        .onBufferMoved = tracked.onMoved,
+        .onImageMoved = {},
+    });
+
+    return true;
+}
+
+inline bool vulkanite::renderer::Defragmenter::moveImage(const TrackedImage& tracked, const VmaDefragmentationMove& move, CommandBuffer& commandBuffer) {
+    constexpr VkImageUsageFlags transferUsage = VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+
+    Image& image = *tracked.image;
+
+    if ((image.usage_ & transferUsage) != transferUsage || !image.subresourceStates_) {
+        return false;
+    }
+
+    VkImageCreateInfo imageCreateInfo = {
+        .sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+        .pNext = nullptr,
+        .flags = 0,
+        .imageType = image.type_,
+        .format = image.format_,
+        .extent = {image.extent_.x, image.extent_.y, image.extent_.z},
+        .mipLevels = image.mipLevels_,
+        .arrayLayers = image.arrayLayers_,
+        .samples = static_cast<VkSampleCountFlagBits>(image.sampleCount_),
+        .tiling = VK_IMAGE_TILING_OPTIMAL,
+        .usage = image.usage_,
+        .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+        .queueFamilyIndexCount = 0,
+        .pQueueFamilyIndices = nullptr,
+        .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+    };
+
+    VkImage newImage = nullptr;
+
+    if (vkCreateImage(device_->device_, &imageCreateInfo, nullptr, &newImage) != VK_SUCCESS) {
+        return false;
+    }
+
+    if (vmaBindImageMemory(device_->allocator_, move.dstTmpAllocation, newImage) != VK_SUCCESS) {
+        vkDestroyImage(device_->device_, newImage, nullptr);
+
+        return false;
+    }
+
+    Image destination;
+
+    destination.image_ = newImage;
+    destination.device_ = device_;
+    destination.extent_ = image.extent_;
+    destination.sampleCount_ = image.sampleCount_;
+    destination.mipLevels_ = image.mipLevels_;
+    destination.arrayLayers_ = image.arrayLayers_;
+    destination.type_ = image.type_;
+    destination.format_ = image.format_;
+
+    destination.initialiseSubresourceStates(0);
+
+    commandBuffer.requireState(image, ImageUsage::TRANSFER_SOURCE);
+    commandBuffer.requireState(destination, ImageUsage::TRANSFER_DESTINATION);
+    commandBuffer.flushBarriers();
+
+    VkImageAspectFlags aspectMask = Image::getAspectMask(image.format_);
+
+    std::vector<VkImageCopy> regions(image.mipLevels_);
+
+    for (std::uint32_t i = 0; i < image.mipLevels_; i++) {
+        VkImageSubresourceLayers subresource = {
+            .aspectMask = aspectMask,
+            .mipLevel = i,
+            .baseArrayLayer = 0,
+            .layerCount = image.arrayLayers_,
+        };
+
+        regions[i] = {
+            .srcSubresource = subresource,
+            .srcOffset = {0, 0, 0},
+            .dstSubresource = subresource,
+            .dstOffset = {0, 0, 0},
+            .extent = {
+                std::max(image.extent_.x >> i, 1u),
+                std::max(image.extent_.y >> i, 1u),
+                std::max(image.extent_.z >> i, 1u),
+            },
+        };
+    }
+
+    vkCmdCopyImage(commandBuffer.commandBuffer_, image.image_, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, newImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, static_cast<std::uint32_t>(regions.size()), regions.data());
+
+    pendingMoves_.push_back({
+        .buffer = nullptr,
+        .image = &image,
+        .newBuffer = nullptr,
+        .newImage = newImage,
+        .newStates = destination.subresourceStates_,
+        .onBufferMoved = {},
+        .onImageMoved = tracked.onMoved,
+    });
+
+    return true;
+}
+
+inline void vulkanite::renderer::Defragmenter::endDefragmentation() {
+    VmaDefragmentationStats stats = {};
+
+    vmaEndDefragmentation(device_->allocator_, context_, &stats);
+
+    context_ = nullptr;
+    bytesMoved_ += stats.bytesMoved;
+    allocationsMoved_ += stats.allocationsMoved;
+}
\ No newline at end of file
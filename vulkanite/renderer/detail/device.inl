@@ -1,17 +1,25 @@
 #pragma once
 
+#include "../command_pool.hpp"
 #include "../configuration.hpp"
 #include "../device.hpp"
 #include "../fence.hpp"
+#include "../image.hpp"
 #include "../instance.hpp"
 #include "../pipeline.hpp"
 #include "../queue.hpp"
 #include "../render_pass.hpp"
+#include "../semaphore.hpp"
 #include "../shader_module.hpp"
 #include "../surface.hpp"
 
+#include <algorithm>
 #include <stdexcept>
+#include <string_view>
+#include <type_traits>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 inline void vulkanite::renderer::Device::create(const DeviceCreateInfo& createInfo) {
     std::vector<std::uint32_t> familyIndexMappings;
@@ -131,6 +139,196 @@ inline void vulkanite::renderer::Device::create(const DeviceCreateInfo& createIn
         throw std::runtime_error("Construction failed: renderer::Device: Failed to enumerate device extensions");
     }
 
+    struct FeatureExtension {
+        Flags feature;
+        std::string_view extension;
+    };
+
+    constexpr FeatureExtension featureExtensions[] = {
+        {DeviceFeatureFlags::EXTENDED_DYNAMIC_STATE, VK_EXT_EXTENDED_DYNAMIC_STATE_EXTENSION_NAME},
+        {DeviceFeatureFlags::EXTENDED_DYNAMIC_STATE_2, VK_EXT_EXTENDED_DYNAMIC_STATE_2_EXTENSION_NAME},
+        {DeviceFeatureFlags::EXTENDED_DYNAMIC_STATE_3, VK_EXT_EXTENDED_DYNAMIC_STATE_3_EXTENSION_NAME},
+        {DeviceFeatureFlags::GRAPHICS_PIPELINE_LIBRARY, VK_KHR_PIPELINE_LIBRARY_EXTENSION_NAME},
+        {DeviceFeatureFlags::GRAPHICS_PIPELINE_LIBRARY, VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME},
+        {DeviceFeatureFlags::SYNCHRONISATION_2, VK_KHR_SYNCHRONIZATION_2_EXTENSION_NAME},
+        {DeviceFeatureFlags::DYNAMIC_RENDERING, VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME},
+        {DeviceFeatureFlags::PRESENT_WAIT, VK_KHR_PRESENT_ID_EXTENSION_NAME},
+        {DeviceFeatureFlags::PRESENT_WAIT, VK_KHR_PRESENT_WAIT_EXTENSION_NAME},
+        {DeviceFeatureFlags::SWAPCHAIN_MAINTENANCE_1, VK_EXT_SWAPCHAIN_MAINTENANCE_1_EXTENSION_NAME},
+        {DeviceFeatureFlags::MEMORY_BUDGET, VK_EXT_MEMORY_BUDGET_EXTENSION_NAME},
+        {DeviceFeatureFlags::BUFFER_DEVICE_ADDRESS, VK_KHR_BUFFER_DEVICE_ADDRESS_EXTENSION_NAME},
+        {DeviceFeatureFlags::MEMORY_PRIORITY, VK_EXT_MEMORY_PRIORITY_EXTENSION_NAME},
+    };
+
+    Flags availableFeatures = createInfo.requestedFeatures;
+
+    for (auto& featureExtension : featureExtensions) {
+        bool found = false;
+
+        for (auto& extensionInfo : extensionProperties) {
+            found |= std::string_view(extensionInfo.extensionName) == featureExtension.extension;
+        }
+
+        if (!found) {
+            availableFeatures &= ~featureExtension.feature;
+        }
+    }
+
+    VkPhysicalDeviceExtendedDynamicStateFeaturesEXT extendedDynamicStateFeatures = {
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_FEATURES_EXT,
+        .pNext = nullptr,
+        .extendedDynamicState = VK_FALSE,
+    };
+
+    VkPhysicalDeviceExtendedDynamicState2FeaturesEXT extendedDynamicState2Features = {
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_2_FEATURES_EXT,
+        .pNext = nullptr,
+        .extendedDynamicState2 = VK_FALSE,
+        .extendedDynamicState2LogicOp = VK_FALSE,
+        .extendedDynamicState2PatchControlPoints = VK_FALSE,
+    };
+
+    VkPhysicalDeviceExtendedDynamicState3FeaturesEXT extendedDynamicState3Features = {
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_3_FEATURES_EXT,
+        .pNext = nullptr,
+    };
+
+    VkPhysicalDeviceGraphicsPipelineLibraryFeaturesEXT graphicsPipelineLibraryFeatures = {
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GRAPHICS_PIPELINE_LIBRARY_FEATURES_EXT,
+        .pNext = nullptr,
+        .graphicsPipelineLibrary = VK_FALSE,
+    };
+
+    VkPhysicalDeviceSynchronization2FeaturesKHR synchronisation2Features = {
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SYNCHRONIZATION_2_FEATURES_KHR,
+        .pNext = nullptr,
+        .synchronization2 = VK_FALSE,
+    };
+
+    VkPhysicalDeviceDynamicRenderingFeaturesKHR dynamicRenderingFeatures = {
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES_KHR,
+        .pNext = nullptr,
+        .dynamicRendering = VK_FALSE,
+    };
+
+    VkPhysicalDevicePresentIdFeaturesKHR presentIdFeatures = {
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_ID_FEATURES_KHR,
+        .pNext = nullptr,
+        .presentId = VK_FALSE,
+    };
+
+    VkPhysicalDevicePresentWaitFeaturesKHR presentWaitFeatures = {
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_WAIT_FEATURES_KHR,
+        .pNext = nullptr,
+        .presentWait = VK_FALSE,
+    };
+
+    VkPhysicalDeviceSwapchainMaintenance1FeaturesEXT swapchainMaintenance1Features = {
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SWAPCHAIN_MAINTENANCE_1_FEATURES_EXT,
+        .pNext = nullptr,
+        .swapchainMaintenance1 = VK_FALSE,
+    };
+
+    VkPhysicalDeviceBufferDeviceAddressFeaturesKHR bufferDeviceAddressFeatures = {
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_BUFFER_DEVICE_ADDRESS_FEATURES_KHR,
+        .pNext = nullptr,
+        .bufferDeviceAddress = VK_FALSE,
+        .bufferDeviceAddressCaptureReplay = VK_FALSE,
+        .bufferDeviceAddressMultiDevice = VK_FALSE,
+    };
+
+    VkPhysicalDeviceMemoryPriorityFeaturesEXT memoryPriorityFeatures = {
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PRIORITY_FEATURES_EXT,
+        .pNext = nullptr,
+        .memoryPriority = VK_FALSE,
+    };
+
+    void* featureChain = nullptr;
+
+    auto chainFeatures = [&](Flags feature, auto& features) {
+        if (availableFeatures & feature) {
+            features.pNext = featureChain;
+            featureChain = &features;
+        }
+    };
+
+    auto buildFeatureChain = [&]() {
+        featureChain = nullptr;
+
+        chainFeatures(DeviceFeatureFlags::EXTENDED_DYNAMIC_STATE, extendedDynamicStateFeatures);
+        chainFeatures(DeviceFeatureFlags::EXTENDED_DYNAMIC_STATE_2, extendedDynamicState2Features);
+        chainFeatures(DeviceFeatureFlags::EXTENDED_DYNAMIC_STATE_3, extendedDynamicState3Features);
+        chainFeatures(DeviceFeatureFlags::GRAPHICS_PIPELINE_LIBRARY, graphicsPipelineLibraryFeatures);
+        chainFeatures(DeviceFeatureFlags::SYNCHRONISATION_2, synchronisation2Features);
+        chainFeatures(DeviceFeatureFlags::DYNAMIC_RENDERING, dynamicRenderingFeatures);
+        chainFeatures(DeviceFeatureFlags::PRESENT_WAIT, presentIdFeatures);
+        chainFeatures(DeviceFeatureFlags::PRESENT_WAIT, presentWaitFeatures);
+        chainFeatures(DeviceFeatureFlags::SWAPCHAIN_MAINTENANCE_1, swapchainMaintenance1Features);
+        chainFeatures(DeviceFeatureFlags::BUFFER_DEVICE_ADDRESS, bufferDeviceAddressFeatures);
+        chainFeatures(DeviceFeatureFlags::MEMORY_PRIORITY, memoryPriorityFeatures);
+    };
+
+    buildFeatureChain();
+
+    if (featureChain != nullptr) {
+        VkPhysicalDeviceFeatures2 supportedFeatures = {
+            .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2,
+            .pNext = featureChain,
+            .features = {},
+        };
+
+        vkGetPhysicalDeviceFeatures2(createInfo.instance.physicalDevice_, &supportedFeatures);
+    }
+
+    if (!extendedDynamicStateFeatures.extendedDynamicState) {
+        availableFeatures &= ~DeviceFeatureFlags::EXTENDED_DYNAMIC_STATE;
+    }
+
+    if (!extendedDynamicState2Features.extendedDynamicState2) {
+        availableFeatures &= ~DeviceFeatureFlags::EXTENDED_DYNAMIC_STATE_2;
+    }
+
+    bool supportsExtendedDynamicState3 = true;
+
+    supportsExtendedDynamicState3 &= extendedDynamicState3Features.extendedDynamicState3DepthClampEnable == VK_TRUE;
+    supportsExtendedDynamicState3 &= extendedDynamicState3Features.extendedDynamicState3ColorBlendEnable == VK_TRUE;
+    supportsExtendedDynamicState3 &= extendedDynamicState3Features.extendedDynamicState3ColorWriteMask == VK_TRUE;
+    supportsExtendedDynamicState3 &= extendedDynamicState3Features.extendedDynamicState3AlphaToCoverageEnable == VK_TRUE;
+
+    if (!supportsExtendedDynamicState3) {
+        availableFeatures &= ~DeviceFeatureFlags::EXTENDED_DYNAMIC_STATE_3;
+    }
+
+    if (!graphicsPipelineLibraryFeatures.graphicsPipelineLibrary) {
+        availableFeatures &= ~DeviceFeatureFlags::GRAPHICS_PIPELINE_LIBRARY;
+    }
+
+    if (!synchronisation2Features.synchronization2) {
+        availableFeatures &= ~DeviceFeatureFlags::SYNCHRONISATION_2;
+    }
+
+    if (!dynamicRenderingFeatures.dynamicRendering) {
+        availableFeatures &= ~DeviceFeatureFlags::DYNAMIC_RENDERING;
+    }
+
+    if (!presentIdFeatures.presentId || !presentWaitFeatures.presentWait) {
+        availableFeatures &= ~DeviceFeatureFlags::PRESENT_WAIT;
+    }
+
+    if (!swapchainMaintenance1Features.swapchainMaintenance1 || !createInfo.instance.supportsSurfaceMaintenance_) {
+        availableFeatures &= ~DeviceFeatureFlags::SWAPCHAIN_MAINTENANCE_1;
+    }
+
+    if (!bufferDeviceAddressFeatures.bufferDeviceAddress) {
+        availableFeatures &= ~DeviceFeatureFlags::BUFFER_DEVICE_ADDRESS;
+    }
+
+    if (!memoryPriorityFeatures.memoryPriority) {
+        availableFeatures &= ~DeviceFeatureFlags::MEMORY_PRIORITY;
+    }
+
+    buildFeatureChain();
+
     std::vector<const char*> selectedExtensions;
 
     for (auto& extensionInfo : extensionProperties) {
@@ -139,6 +337,12 @@ inline void vulkanite::renderer::Device::create(const DeviceCreateInfo& createIn
         match |= std::string_view(extensionInfo.extensionName) == "VK_KHR_swapchain";
         match |= std::string_view(extensionInfo.extensionName) == "VK_KHR_portability_subset";
 
+        for (auto& featureExtension : featureExtensions) {
+            if (availableFeatures & featureExtension.feature) {
+                match |= std::string_view(extensionInfo.extensionName) == featureExtension.extension;
+            }
+        }
+
         if (match) {
             selectedExtensions.push_back(extensionInfo.extensionName);
         }
@@ -149,7 +353,7 @@ inline void vulkanite::renderer::Device::create(const DeviceCreateInfo& createIn
 
     VkDeviceCreateInfo deviceCreateInfo = {
         .sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO,
-        .pNext = nullptr,
+        .pNext = featureChain,
         .flags = 0,
         .queueCreateInfoCount = queueCreateInfoCount,
         .pQueueCreateInfos = queueCreateInfos.data(),
@@ -168,13 +372,34 @@ inline void vulkanite::renderer::Device::create(const DeviceCreateInfo& createIn
     }
 
     instance_ = &createInfo.instance;
+    enabledFeatures_ = availableFeatures;
 
     for (auto& queue : queues_) {
         vkGetDeviceQueue(device_, queue.familyIndex_, queue.queueIndex_, &queue.queue_);
+
+        std::uint64_t stripe = (static_cast<std::uint64_t>(queue.familyIndex_) * 31 + queue.queueIndex_) % queueMutexes_.size();
+
+        queue.mutex_ = &queueMutexes_[stripe];
+    }
+
+    loadFunctions();
+
+    VmaAllocatorCreateFlags allocatorFlags = 0;
+
+    if (enabledFeatures_ & DeviceFeatureFlags::MEMORY_BUDGET) {
+        allocatorFlags |= VMA_ALLOCATOR_CREATE_EXT_MEMORY_BUDGET_BIT;
+    }
+
+    if (enabledFeatures_ & DeviceFeatureFlags::BUFFER_DEVICE_ADDRESS) {
+        allocatorFlags |= VMA_ALLOCATOR_CREATE_BUFFER_DEVICE_ADDRESS_BIT;
+    }
+
+    if (enabledFeatures_ & DeviceFeatureFlags::MEMORY_PRIORITY) {
+        allocatorFlags |= VMA_ALLOCATOR_CREATE_EXT_MEMORY_PRIORITY_BIT;
     }
 
     VmaAllocatorCreateInfo allocatorCreateInfo = {
-        .flags = 0,
+        .flags = allocatorFlags,
         .physicalDevice = instance_->physicalDevice_,
         .device = device_,
         .preferredLargeHeapBlockSize = 0,
@@ -195,6 +420,38 @@ inline void vulkanite::renderer::Device::create(const DeviceCreateInfo& createIn
 }
 
 inline void vulkanite::renderer::Device::destroy() {
+    {
+        std::lock_guard<std::mutex> lock(threadCommandPoolMutex_);
+
+        for (auto& [key, commandPool] : threadCommandPools_) {
+            commandPool->destroy();
+        }
+
+        threadCommandPools_.clear();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(synchronisationPoolMutex_);
+
+        for (VkFence fence : freeFences_) {
+            vkDestroyFence(device_, fence, nullptr);
+        }
+
+        for (VkSemaphore semaphore : freeSemaphores_) {
+            vkDestroySemaphore(device_, semaphore, nullptr);
+        }
+
+        for (auto& pending : pendingSemaphores_) {
+            for (VkSemaphore semaphore : pending.semaphores) {
+                vkDestroySemaphore(device_, semaphore, nullptr);
+            }
+        }
+
+        freeFences_.clear();
+        freeSemaphores_.clear();
+        pendingSemaphores_.clear();
+    }
+
     if (allocator_) {
         vmaDestroyAllocator(allocator_);
 
@@ -206,9 +463,26 @@ inline void vulkanite::renderer::Device::destroy() {
 
         device_ = nullptr;
     }
+
+    enabledFeatures_ = DeviceFeatureFlags::NONE;
+    functions_ = {};
+
+    std::lock_guard<std::mutex> lock(memoryPressureMutex_);
+
+    memoryPressureHandlers_.clear();
+    budgetFrameIndex_ = 0;
 }
 
 inline bool vulkanite::renderer::Device::waitIdle() {
+    std::vector<std::unique_lock<std::mutex>> locks;
+
+    locks.reserve(queueMutexes_.size());
+
+    // vkDeviceWaitIdle needs every queue externally synchronised, always taken in stripe order
+    for (auto& mutex : queueMutexes_) {
+        locks.emplace_back(mutex);
+    }
+
     return vkDeviceWaitIdle(device_) == VK_SUCCESS;
 }
 
@@ -232,12 +506,154 @@ inline bool vulkanite::renderer::Device::resetFences(const std::vector<Fence>& f
     return vkResetFences(device_, static_cast<std::uint32_t>(vkFences.size()), vkFences.data()) == VK_SUCCESS;
 }
 
+inline vulkanite::renderer::Fence vulkanite::renderer::Device::acquireFence() {
+    Fence fence;
+
+    fence.device_ = this;
+
+    {
+        std::lock_guard<std::mutex> lock(synchronisationPoolMutex_);
+
+        if (!freeFences_.empty()) {
+            fence.fence_ = freeFences_.back();
+            freeFences_.pop_back();
+
+            return fence;
+        }
+    }
+
+    VkFenceCreateInfo fenceCreateInfo = {
+        .sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO,
+        .pNext = nullptr,
+        .flags = 0,
+    };
+
+    if (vkCreateFence(device_, &fenceCreateInfo, nullptr, &fence.fence_) != VK_SUCCESS) {
+        throw std::runtime_error("Call failed: renderer::Device::acquireFence(): Failed to create fence");
+    }
+
+    return fence;
+}
+
+inline bool vulkanite::renderer::Device::recycleFences(std::vector<Fence>& fences) {
+    std::lock_guard<std::mutex> lock(synchronisationPoolMutex_);
+
+    std::vector<Fence> recyclable;
+
+    recyclable.reserve(fences.size());
+
+    for (auto& fence : fences) {
+        bool duplicate = std::any_of(recyclable.begin(), recyclable.end(), [&](const Fence& other) {
+            return other.fence_ == fence.fence_;
+        });
+
+        if (fence.fence_ && !duplicate && std::find(freeFences_.begin(), freeFences_.end(), fence.fence_) == freeFences_.end()) {
+            recyclable.push_back(fence);
+        }
+    }
+
+    if (!recyclable.empty() && !resetFences(recyclable)) {
+        return false;
+    }
+
+    // a fence can only be recycled once its work is done, so semaphores tied to it are free too
+    for (auto& fence : recyclable) {
+        releasePendingSemaphores(fence.fence_);
+
+        freeFences_.push_back(fence.fence_);
+    }
+
+    for (auto& fence : fences) {
+        fence.fence_ = nullptr;
+    }
+
+    return true;
+}
+
+inline vulkanite::renderer::Semaphore vulkanite::renderer::Device::acquireSemaphore() {
+    Semaphore semaphore;
+
+    semaphore.device_ = this;
+
+    {
+        std::lock_guard<std::mutex> lock(synchronisationPoolMutex_);
+
+        if (freeSemaphores_.empty()) {
+            collectSignalledSemaphores();
+        }
+
+        if (!freeSemaphores_.empty()) {
+            semaphore.semaphore_ = freeSemaphores_.back();
+            freeSemaphores_.pop_back();
+
+            return semaphore;
+        }
+    }
+
+    VkSemaphoreCreateInfo semaphoreCreateInfo = {
+        .sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO,
+        .pNext = nullptr,
+        .flags = 0,
+    };
+
+    if (vkCreateSemaphore(device_, &semaphoreCreateInfo, nullptr, &semaphore.semaphore_) != VK_SUCCESS) {
+        throw std::runtime_error("Call failed: renderer::Device::acquireSemaphore(): Failed to create semaphore");
+    }
+
+    return semaphore;
+}
+
+inline void vulkanite::renderer::Device::releaseSemaphores(std::vector<Semaphore>& semaphores) {
+    std::lock_guard<std::mutex> lock(synchronisationPoolMutex_);
+
+    for (auto& semaphore : semaphores) {
+        if (semaphore.semaphore_ && !isSemaphorePooled(semaphore.semaphore_)) {
+            freeSemaphores_.push_back(semaphore.semaphore_);
+        }
+
+        semaphore.semaphore_ = nullptr;
+    }
+}
+
+inline void vulkanite::renderer::Device::releaseSemaphoresAfter(std::vector<Semaphore>& semaphores, const Fence& fence) {
+    if (!fence.fence_) {
+        throw std::runtime_error("Call failed: renderer::Device::releaseSemaphoresAfter(): Fence is not valid");
+    }
+
+    PendingSemaphores pending = {
+        .fence = fence.fence_,
+        .semaphores = {},
+    };
+
+    pending.semaphores.reserve(semaphores.size());
+
+    std::lock_guard<std::mutex> lock(synchronisationPoolMutex_);
+
+    for (auto& semaphore : semaphores) {
+        bool duplicate = std::find(pending.semaphores.begin(), pending.semaphores.end(), semaphore.semaphore_) != pending.semaphores.end();
+
+        if (semaphore.semaphore_ && !duplicate && !isSemaphorePooled(semaphore.semaphore_)) {
+            pending.semaphores.push_back(semaphore.semaphore_);
+        }
+
+        semaphore.semaphore_ = nullptr;
+    }
+
+    if (!pending.semaphores.empty()) {
+        pendingSemaphores_.push_back(std::move(pending));
+    }
+}
+
 inline std::vector<vulkanite::renderer::Pipeline> vulkanite::renderer::Device::createPipelines(const std::vector<PipelineCreateInfo>& createInfos) {
     struct PipelineCreationData {
         std::vector<VkPipelineShaderStageCreateInfo> shaderStages;
+        std::vector<std::vector<VkSpecializationMapEntry>> specialisationEntries;
+        std::vector<VkSpecializationInfo> specialisationInfos;
         std::vector<VkVertexInputBindingDescription> bindings;
         std::vector<VkVertexInputAttributeDescription> attributes;
         std::vector<VkPipelineColorBlendAttachmentState> blendAttachments;
+        std::vector<VkDynamicState> dynamicStates;
+        std::vector<VkFormat> colourFormats;
 
         VkPipelineVertexInputStateCreateInfo vertexInput;
         VkPipelineInputAssemblyStateCreateInfo inputAssembly;
@@ -246,6 +662,34 @@ inline std::vector<vulkanite::renderer::Pipeline> vulkanite::renderer::Device::c
         VkPipelineMultisampleStateCreateInfo multisample;
         VkPipelineDepthStencilStateCreateInfo depthStencil;
         VkPipelineColorBlendStateCreateInfo colourBlend;
+        VkPipelineDynamicStateCreateInfo dynamicState;
+        VkGraphicsPipelineLibraryCreateInfoEXT library;
+        VkPipelineRenderingCreateInfoKHR rendering;
+    };
+
+    struct DynamicStateMap {
+        Flags flag;
+        VkDynamicState vkState;
+        Flags feature;
+    };
+
+    constexpr DynamicStateMap dynamicStateMapping[] = {
+        {DynamicStateFlags::CULL_MODE, VK_DYNAMIC_STATE_CULL_MODE_EXT, DeviceFeatureFlags::EXTENDED_DYNAMIC_STATE},
+        {DynamicStateFlags::FRONT_FACE, VK_DYNAMIC_STATE_FRONT_FACE_EXT, DeviceFeatureFlags::EXTENDED_DYNAMIC_STATE},
+        {DynamicStateFlags::PRIMITIVE_TOPOLOGY, VK_DYNAMIC_STATE_PRIMITIVE_TOPOLOGY_EXT, DeviceFeatureFlags::EXTENDED_DYNAMIC_STATE},
+        {DynamicStateFlags::DEPTH_TEST_ENABLE, VK_DYNAMIC_STATE_DEPTH_TEST_ENABLE_EXT, DeviceFeatureFlags::EXTENDED_DYNAMIC_STATE},
+        {DynamicStateFlags::DEPTH_WRITE_ENABLE, VK_DYNAMIC_STATE_DEPTH_WRITE_ENABLE_EXT, DeviceFeatureFlags::EXTENDED_DYNAMIC_STATE},
+        {DynamicStateFlags::DEPTH_COMPARE_OPERATION, VK_DYNAMIC_STATE_DEPTH_COMPARE_OP_EXT, DeviceFeatureFlags::EXTENDED_DYNAMIC_STATE},
+        {DynamicStateFlags::DEPTH_BOUNDS_TEST_ENABLE, VK_DYNAMIC_STATE_DEPTH_BOUNDS_TEST_ENABLE_EXT, DeviceFeatureFlags::EXTENDED_DYNAMIC_STATE},
+        {DynamicStateFlags::STENCIL_TEST_ENABLE, VK_DYNAMIC_STATE_STENCIL_TEST_ENABLE_EXT, DeviceFeatureFlags::EXTENDED_DYNAMIC_STATE},
+        {DynamicStateFlags::STENCIL_OPERATION, VK_DYNAMIC_STATE_STENCIL_OP_EXT, DeviceFeatureFlags::EXTENDED_DYNAMIC_STATE},
+        {DynamicStateFlags::DEPTH_BIAS_ENABLE, VK_DYNAMIC_STATE_DEPTH_BIAS_ENABLE_EXT, DeviceFeatureFlags::EXTENDED_DYNAMIC_STATE_2},
+        {DynamicStateFlags::PRIMITIVE_RESTART_ENABLE, VK_DYNAMIC_STATE_PRIMITIVE_RESTART_ENABLE_EXT, DeviceFeatureFlags::EXTENDED_DYNAMIC_STATE_2},
+        {DynamicStateFlags::RASTERISER_DISCARD_ENABLE, VK_DYNAMIC_STATE_RASTERIZER_DISCARD_ENABLE_EXT, DeviceFeatureFlags::EXTENDED_DYNAMIC_STATE_2},
+        {DynamicStateFlags::DEPTH_CLAMP_ENABLE, VK_DYNAMIC_STATE_DEPTH_CLAMP_ENABLE_EXT, DeviceFeatureFlags::EXTENDED_DYNAMIC_STATE_3},
+        {DynamicStateFlags::COLOUR_BLEND_ENABLE, VK_DYNAMIC_STATE_COLOR_BLEND_ENABLE_EXT, DeviceFeatureFlags::EXTENDED_DYNAMIC_STATE_3},
+        {DynamicStateFlags::COLOUR_WRITE_MASK, VK_DYNAMIC_STATE_COLOR_WRITE_MASK_EXT, DeviceFeatureFlags::EXTENDED_DYNAMIC_STATE_3},
+        {DynamicStateFlags::ALPHA_TO_COVERAGE_ENABLE, VK_DYNAMIC_STATE_ALPHA_TO_COVERAGE_ENABLE_EXT, DeviceFeatureFlags::EXTENDED_DYNAMIC_STATE_3},
     };
 
     std::vector<VkGraphicsPipelineCreateInfo> pipelineCreateInfos(createInfos.size());
@@ -255,48 +699,98 @@ inline std::vector<vulkanite::renderer::Pipeline> vulkanite::renderer::Device::c
 
     pipelines.reserve(createInfos.size());
 
-    std::vector<VkDynamicState> dynamicStates = {
-        VK_DYNAMIC_STATE_VIEWPORT,
-        VK_DYNAMIC_STATE_SCISSOR,
-        VK_DYNAMIC_STATE_LINE_WIDTH,
-        VK_DYNAMIC_STATE_DEPTH_BIAS,
-        VK_DYNAMIC_STATE_BLEND_CONSTANTS,
-        VK_DYNAMIC_STATE_DEPTH_BOUNDS,
-        VK_DYNAMIC_STATE_STENCIL_COMPARE_MASK,
-        VK_DYNAMIC_STATE_STENCIL_WRITE_MASK,
-        VK_DYNAMIC_STATE_STENCIL_REFERENCE,
-    };
-
-    VkPipelineDynamicStateCreateInfo dynamicStateInfo = {
-        .sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO,
-        .pNext = nullptr,
-        .flags = 0,
-        .dynamicStateCount = static_cast<std::uint32_t>(dynamicStates.size()),
-        .pDynamicStates = dynamicStates.data(),
-    };
-
     for (std::uint64_t i = 0; i < createInfos.size(); i++) {
         auto& createInfo = createInfos[i];
         auto& createData = creationData[i];
         auto& pipelineCreateInfo = pipelineCreateInfos[i];
 
-        createData.shaderStages.resize(createInfo.shaderStages.size());
+        createData.shaderStages.reserve(createInfo.shaderStages.size());
+        createData.specialisationEntries.resize(createInfo.shaderStages.size());
+        createData.specialisationInfos.resize(createInfo.shaderStages.size());
         createData.bindings.resize(createInfo.vertexInput.bindings.size());
         createData.attributes.resize(createInfo.vertexInput.attributes.size());
         createData.blendAttachments.resize(createInfo.colourBlend.attachments.size());
 
-        for (std::uint64_t j = 0; j < createData.shaderStages.size(); j++) {
-            auto& info = createData.shaderStages[j];
+        createData.dynamicStates = {
+            VK_DYNAMIC_STATE_VIEWPORT,
+            VK_DYNAMIC_STATE_SCISSOR,
+            VK_DYNAMIC_STATE_LINE_WIDTH,
+            VK_DYNAMIC_STATE_DEPTH_BIAS,
+            VK_DYNAMIC_STATE_BLEND_CONSTANTS,
+            VK_DYNAMIC_STATE_DEPTH_BOUNDS,
+            VK_DYNAMIC_STATE_STENCIL_COMPARE_MASK,
+            VK_DYNAMIC_STATE_STENCIL_WRITE_MASK,
+            VK_DYNAMIC_STATE_STENCIL_REFERENCE,
+        };
+
+        for (auto& mapping : dynamicStateMapping) {
+            if (!(createInfo.dynamicStateFlags & mapping.flag)) {
+                continue;
+            }
+
+            if (!(enabledFeatures_ & mapping.feature)) {
+                throw std::runtime_error("Call failed: renderer::Device::createPipelines(): Dynamic state requested without enabling the matching device feature");
+            }
+
+            createData.dynamicStates.push_back(mapping.vkState);
+        }
+
+        bool isLibrary = createInfo.libraryFlags != PipelineLibraryFlags::NONE;
+
+        if (isLibrary && !(enabledFeatures_ & DeviceFeatureFlags::GRAPHICS_PIPELINE_LIBRARY)) {
+            throw std::runtime_error("Call failed: renderer::Device::createPipelines(): Pipeline library requested without enabling the graphics pipeline library feature");
+        }
+
+        for (std::uint64_t j = 0; j < createInfo.shaderStages.size(); j++) {
             auto& stage = createInfo.shaderStages[j];
 
+            if (isLibrary) {
+                bool isFragmentStage = stage.stage == ShaderStage::FRAGMENT;
+
+                if (isFragmentStage && !(createInfo.libraryFlags & PipelineLibraryFlags::FRAGMENT_SHADER)) {
+                    continue;
+                }
+
+                if (!isFragmentStage && !(createInfo.libraryFlags & PipelineLibraryFlags::PRE_RASTERISATION)) {
+                    continue;
+                }
+            }
+
+            auto& info = createData.shaderStages.emplace_back();
+            auto& entries = createData.specialisationEntries[j];
+            auto& specialisationInfo = createData.specialisationInfos[j];
+
+            entries.resize(stage.specialisationConstants.size());
+
+            for (std::uint64_t k = 0; k < entries.size(); k++) {
+                auto& constant = stage.specialisationConstants[k];
+
+                if (constant.offsetBytes + constant.sizeBytes > stage.specialisationData.size()) {
+                    throw std::runtime_error("Call failed: renderer::Device::createPipelines(): Specialisation constant lies outside of the provided specialisation data");
+                }
+
+                entries[k] = {
+                    .constantID = constant.constantID,
+                    .offset = constant.offsetBytes,
+                    .size = constant.sizeBytes,
+                };
+            }
+
+            specialisationInfo = {
+                .mapEntryCount = static_cast<std::uint32_t>(entries.size()),
+                .pMapEntries = entries.data(),
+                .dataSize = stage.specialisationData.size(),
+                .pData = stage.specialisationData.data(),
+            };
+
             info = {
                 .sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
                 .pNext = nullptr,
                 .flags = 0,
                 .stage = Pipeline::reverseMapShaderStage(stage.stage),
                 .module = stage.module.module_,
-                .pName = "main",
-                .pSpecializationInfo = nullptr,
+                .pName = stage.entryPoint.c_str(),
+                .pSpecializationInfo = entries.empty() ? nullptr : &specialisationInfo,
             };
         }
 
@@ -365,7 +859,7 @@ inline std::vector<vulkanite::renderer::Pipeline> vulkanite::renderer::Device::c
                 .srcAlphaBlendFactor = Pipeline::reverseMapBlendFactor(attachment.sourceAlphaBlendFactor),
                 .dstAlphaBlendFactor = Pipeline::reverseMapBlendFactor(attachment.destinationAlphaBlendFactor),
                 .alphaBlendOp = Pipeline::reverseMapBlendOperation(attachment.alphaBlendOperation),
-                .colorWriteMask = 0xF,
+                .colorWriteMask = ColourComponentFlags::mapFrom(attachment.colourWriteMask),
             };
         }
 
@@ -451,10 +945,72 @@ inline std::vector<vulkanite::renderer::Pipeline> vulkanite::renderer::Device::c
             .blendConstants = {},
         };
 
-        pipelineCreateInfo = {
-            .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
+        createData.dynamicState = {
+            .sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO,
             .pNext = nullptr,
             .flags = 0,
+            .dynamicStateCount = static_cast<std::uint32_t>(createData.dynamicStates.size()),
+            .pDynamicStates = createData.dynamicStates.data(),
+        };
+
+        bool usesDynamicRendering = createInfo.renderPass == nullptr;
+
+        if (usesDynamicRendering && !(enabledFeatures_ & DeviceFeatureFlags::DYNAMIC_RENDERING)) {
+            throw std::runtime_error("Call failed: renderer::Device::createPipelines(): Pipeline without a render pass requested without enabling the dynamic rendering feature");
+        }
+
+        VkFormat depthStencilFormat = VK_FORMAT_UNDEFINED;
+        VkImageAspectFlags depthStencilAspects = 0;
+
+        if (usesDynamicRendering) {
+            createData.colourFormats.resize(createInfo.rendering.colourFormats.size());
+
+            for (std::uint64_t j = 0; j < createData.colourFormats.size(); j++) {
+                createData.colourFormats[j] = Image::mapFormat(createInfo.rendering.colourFormats[j], *instance_);
+            }
+
+            if (createInfo.rendering.depthStencilFormat) {
+                depthStencilFormat = Image::mapFormat(createInfo.rendering.depthStencilFormat.value(), *instance_);
+                depthStencilAspects = Image::getAspectMask(depthStencilFormat);
+            }
+        }
+
+        createData.rendering = {
+            .sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO_KHR,
+            .pNext = nullptr,
+            .viewMask = 0,
+            .colorAttachmentCount = static_cast<std::uint32_t>(createData.colourFormats.size()),
+            .pColorAttachmentFormats = createData.colourFormats.data(),
+            .depthAttachmentFormat = (depthStencilAspects & VK_IMAGE_ASPECT_DEPTH_BIT) ? depthStencilFormat : VK_FORMAT_UNDEFINED,
+            .stencilAttachmentFormat = (depthStencilAspects & VK_IMAGE_ASPECT_STENCIL_BIT) ? depthStencilFormat : VK_FORMAT_UNDEFINED,
+        };
+
+        createData.library = {
+            .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_LIBRARY_CREATE_INFO_EXT,
+            .pNext = usesDynamicRendering ? &createData.rendering : nullptr,
+            .flags = PipelineLibraryFlags::mapFrom(createInfo.libraryFlags),
+        };
+
+        const void* pipelineNext = nullptr;
+
+        if (isLibrary) {
+            pipelineNext = &createData.library;
+        }
+        else if (usesDynamicRendering) {
+            pipelineNext = &createData.rendering;
+        }
+
+        VkPipelineCreateFlags pipelineFlags = 0;
+
+        if (isLibrary) {
+            pipelineFlags |= VK_PIPELINE_CREATE_LIBRARY_BIT_KHR;
+            pipelineFlags |= VK_PIPELINE_CREATE_RETAIN_LINK_TIME_OPTIMIZATION_INFO_BIT_EXT;
+        }
+
+        pipelineCreateInfo = {
+            .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
+            .pNext = pipelineNext,
+            .flags = pipelineFlags,
             .stageCount = static_cast<std::uint32_t>(createData.shaderStages.size()),
             .pStages = createData.shaderStages.data(),
             .pVertexInputState = &createData.vertexInput,
@@ -465,9 +1021,9 @@ inline std::vector<vulkanite::renderer::Pipeline> vulkanite::renderer::Device::c
             .pMultisampleState = &createData.multisample,
             .pDepthStencilState = &createData.depthStencil,
             .pColorBlendState = &createData.colourBlend,
-            .pDynamicState = &dynamicStateInfo,
+            .pDynamicState = &createData.dynamicState,
             .layout = createInfo.layout.pipelineLayout_,
-            .renderPass = createInfo.renderPass.renderPass_,
+            .renderPass = usesDynamicRendering ? nullptr : createInfo.renderPass->renderPass_,
             .subpass = createInfo.subpassIndex,
             .basePipelineHandle = nullptr,
             .basePipelineIndex = 0,
@@ -478,13 +1034,94 @@ inline std::vector<vulkanite::renderer::Pipeline> vulkanite::renderer::Device::c
         return {};
     }
 
-    for (auto& vkPipeline : pipelineHandles) {
+    for (std::uint64_t i = 0; i < pipelineHandles.size(); i++) {
+        pipelines.push_back(Pipeline());
+
+        auto& pipeline = pipelines.back();
+
+        pipeline.pipeline_ = pipelineHandles[i];
+        pipeline.device_ = this;
+        pipeline.dynamicStateFlags_ = createInfos[i].dynamicStateFlags;
+        pipeline.libraryFlags_ = createInfos[i].libraryFlags;
+    }
+
+    return pipelines;
+}
+
+inline std::vector<vulkanite::renderer::Pipeline> vulkanite::renderer::Device::linkPipelines(const std::vector<PipelineLinkInfo>& linkInfos) {
+    if (!(enabledFeatures_ & DeviceFeatureFlags::GRAPHICS_PIPELINE_LIBRARY)) {
+        throw std::runtime_error("Call failed: renderer::Device::linkPipelines(): Graphics pipeline library feature is not enabled");
+    }
+
+    std::vector<VkGraphicsPipelineCreateInfo> pipelineCreateInfos(linkInfos.size());
+    std::vector<VkPipelineLibraryCreateInfoKHR> libraryCreateInfos(linkInfos.size());
+    std::vector<std::vector<VkPipeline>> libraryHandles(linkInfos.size());
+    std::vector<VkPipeline> pipelineHandles(linkInfos.size(), nullptr);
+    std::vector<Flags> dynamicStateFlags(linkInfos.size(), DynamicStateFlags::NONE);
+    std::vector<Pipeline> pipelines;
+
+    pipelines.reserve(linkInfos.size());
+
+    for (std::uint64_t i = 0; i < linkInfos.size(); i++) {
+        auto& linkInfo = linkInfos[i];
+        auto& libraries = libraryHandles[i];
+
+        Flags linkedParts = PipelineLibraryFlags::NONE;
+
+        libraries.resize(linkInfo.libraries.size());
+
+        for (std::uint64_t j = 0; j < libraries.size(); j++) {
+            libraries[j] = linkInfo.libraries[j].pipeline_;
+            linkedParts |= linkInfo.libraries[j].libraryFlags_;
+            dynamicStateFlags[i] |= linkInfo.libraries[j].dynamicStateFlags_;
+        }
+
+        if (linkedParts != PipelineLibraryFlags::ALL) {
+            throw std::runtime_error("Call failed: renderer::Device::linkPipelines(): Libraries do not cover every graphics pipeline part");
+        }
+
+        libraryCreateInfos[i] = {
+            .sType = VK_STRUCTURE_TYPE_PIPELINE_LIBRARY_CREATE_INFO_KHR,
+            .pNext = nullptr,
+            .libraryCount = static_cast<std::uint32_t>(libraries.size()),
+            .pLibraries = libraries.data(),
+        };
+
+        pipelineCreateInfos[i] = {
+            .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
+            .pNext = &libraryCreateInfos[i],
+            .flags = linkInfo.optimise ? static_cast<VkPipelineCreateFlags>(VK_PIPELINE_CREATE_LINK_TIME_OPTIMIZATION_BIT_EXT) : 0,
+            .stageCount = 0,
+            .pStages = nullptr,
+            .pVertexInputState = nullptr,
+            .pInputAssemblyState = nullptr,
+            .pTessellationState = nullptr,
+            .pViewportState = nullptr,
+            .pRasterizationState = nullptr,
+            .pMultisampleState = nullptr,
+            .pDepthStencilState = nullptr,
+            .pColorBlendState = nullptr,
+            .pDynamicState = nullptr,
+            .layout = linkInfo.layout.pipelineLayout_,
+            .renderPass = nullptr,
+            .subpass = 0,
+            .basePipelineHandle = nullptr,
+            .basePipelineIndex = 0,
+        };
+    }
+
+    if (vkCreateGraphicsPipelines(device_, nullptr, static_cast<std::uint32_t>(pipelineCreateInfos.size()), pipelineCreateInfos.data(), nullptr, pipelineHandles.data()) != VK_SUCCESS) {
+        return {};
+    }
+
+    for (std::uint64_t i = 0; i < pipelineHandles.size(); i++) {
         pipelines.push_back(Pipeline());
 
         auto& pipeline = pipelines.back();
 
-        pipeline.pipeline_ = vkPipeline;
+        pipeline.pipeline_ = pipelineHandles[i];
         pipeline.device_ = this;
+        pipeline.dynamicStateFlags_ = dynamicStateFlags[i];
     }
 
     return pipelines;
@@ -492,4 +1129,236 @@ inline std::vector<vulkanite::renderer::Pipeline> vulkanite::renderer::Device::c
 
 inline std::span<vulkanite::renderer::Queue> vulkanite::renderer::Device::getQueues() {
     return queues_;
+}
+
+inline vulkanite::renderer::CommandPool& vulkanite::renderer::Device::getThreadCommandPool(Queue& queue) {
+    std::lock_guard<std::mutex> lock(threadCommandPoolMutex_);
+
+    auto key = std::make_pair(std::this_thread::get_id(), queue.familyIndex_);
+    auto& commandPool = threadCommandPools_[key];
+
+    if (!commandPool) {
+        commandPool = std::make_unique<CommandPool>();
+
+        CommandPoolCreateInfo createInfo = {
+            .device = *this,
+            .queue = queue,
+        };
+
+        commandPool->create(createInfo);
+
+        if (!commandPool->commandPool_) {
+            threadCommandPools_.erase(key);
+
+            throw std::runtime_error("Call failed: renderer::Device::getThreadCommandPool(): Failed to create command pool");
+        }
+    }
+
+    return *commandPool;
+}
+
+inline void vulkanite::renderer::Device::releaseThreadCommandPools() {
+    std::lock_guard<std::mutex> lock(threadCommandPoolMutex_);
+
+    std::thread::id thread = std::this_thread::get_id();
+
+    for (auto it = threadCommandPools_.begin(); it != threadCommandPools_.end();) {
+        if (it->first.first == thread) {
+            it->second->destroy();
+            it = threadCommandPools_.erase(it);
+        }
+        else {
+            it++;
+        }
+    }
+}
+
+inline vulkanite::renderer::Flags vulkanite::renderer::Device::getEnabledFeatures() const {
+    return enabledFeatures_;
+}
+
+inline bool vulkanite::renderer::Device::supportsDeviceLocalHostVisibleMemory() const {
+    return instance_->supportsLargeHostVisibleHeap_;
+}
+
+inline std::vector<vulkanite::renderer::MemoryHeapBudget> vulkanite::renderer::Device::getMemoryBudget() const {
+    const VkPhysicalDeviceMemoryProperties& memoryProperties = instance_->memoryProperties_;
+
+    std::vector<VmaBudget> vmaBudgets(memoryProperties.memoryHeapCount);
+
+    vmaGetHeapBudgets(allocator_, vmaBudgets.data());
+
+    std::vector<MemoryHeapBudget> budgets(memoryProperties.memoryHeapCount);
+
+    for (std::uint32_t i = 0; i < memoryProperties.memoryHeapCount; i++) {
+        budgets[i] = {
+            .heapIndex = i,
+            .usageBytes = vmaBudgets[i].usage,
+            .budgetBytes = vmaBudgets[i].budget,
+            .allocatedBytes = vmaBudgets[i].statistics.allocationBytes,
+            .isDeviceLocal = (memoryProperties.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) != 0,
+        };
+    }
+
+    return budgets;
+}
+
+inline void vulkanite::renderer::Device::updateMemoryBudget() {
+    // VMA only refreshes its cached budget when the frame index changes
+    vmaSetCurrentFrameIndex(allocator_, ++budgetFrameIndex_);
+
+    std::vector<MemoryHeapBudget> budgets = getMemoryBudget();
+    std::vector<std::function<void()>> notifications;
+
+    std::unique_lock<std::mutex> lock(memoryPressureMutex_);
+
+    for (auto& handler : memoryPressureHandlers_) {
+        handler.triggered.resize(budgets.size(), false);
+
+        for (std::uint64_t i = 0; i < budgets.size(); i++) {
+            const MemoryHeapBudget& budget = budgets[i];
+
+            if (budget.budgetBytes == 0) {
+                continue;
+            }
+
+            float pressure = static_cast<float>(budget.usageBytes) / static_cast<float>(budget.budgetBytes);
+
+            if (pressure < handler.threshold) {
+                handler.triggered[i] = false;
+            }
+            else if (!handler.triggered[i]) {
+                handler.triggered[i] = true;
+
+                notifications.push_back([callback = handler.callback, budget, threshold = handler.threshold]() {
+                    callback(budget, threshold);
+                });
+            }
+        }
+    }
+
+    lock.unlock();
+
+    // callbacks run unlocked so they can add or remove handlers themselves
+    for (auto& notification : notifications) {
+        notification();
+    }
+}
+
+inline std::uint32_t vulkanite::renderer::Device::addMemoryPressureCallback(float threshold, MemoryPressureCallback callback) {
+    if (!callback) {
+        throw std::runtime_error("Call failed: renderer::Device::addMemoryPressureCallback(): Callback is empty");
+    }
+
+    std::lock_guard<std::mutex> lock(memoryPressureMutex_);
+
+    std::uint32_t id = nextMemoryPressureHandlerId_++;
+
+    memoryPressureHandlers_.push_back({
+        .id = id,
+        .threshold = threshold,
+        .callback = std::move(callback),
+        .triggered = {},
+    });
+
+    return id;
+}
+
+inline void vulkanite::renderer::Device::removeMemoryPressureCallback(std::uint32_t callbackId) {
+    std::lock_guard<std::mutex> lock(memoryPressureMutex_);
+
+    std::erase_if(memoryPressureHandlers_, [callbackId](const MemoryPressureHandler& handler) {
+        return handler.id == callbackId;
+    });
+}
+
+inline void vulkanite::renderer::Device::releasePendingSemaphores(VkFence fence) {
+    std::erase_if(pendingSemaphores_, [&](PendingSemaphores& pending) {
+        if (pending.fence != fence) {
+            return false;
+        }
+
+        freeSemaphores_.insert(freeSemaphores_.end(), pending.semaphores.begin(), pending.semaphores.end());
+
+        return true;
+    });
+}
+
+inline void vulkanite::renderer::Device::forgetFence(VkFence fence) {
+    std::lock_guard<std::mutex> lock(synchronisationPoolMutex_);
+
+    // a fence may only be destroyed once its work has completed, so its semaphores are safe to reuse
+    releasePendingSemaphores(fence);
+
+    std::erase(freeFences_, fence);
+}
+
+inline bool vulkanite::renderer::Device::isSemaphorePooled(VkSemaphore semaphore) const {
+    if (std::find(freeSemaphores_.begin(), freeSemaphores_.end(), semaphore) != freeSemaphores_.end()) {
+        return true;
+    }
+
+    return std::any_of(pendingSemaphores_.begin(), pendingSemaphores_.end(), [&](const PendingSemaphores& pending) {
+        return std::find(pending.semaphores.begin(), pending.semaphores.end(), semaphore) != pending.semaphores.end();
+    });
+}
+
+inline void vulkanite::renderer::Device::collectSignalledSemaphores() {
+    std::erase_if(pendingSemaphores_, [this](PendingSemaphores& pending) {
+        if (vkGetFenceStatus(device_, pending.fence) != VK_SUCCESS) {
+            return false;
+        }
+
+        freeSemaphores_.insert(freeSemaphores_.end(), pending.semaphores.begin(), pending.semaphores.end());
+
+        return true;
+    });
+}
+
+inline void vulkanite::renderer::Device::loadFunctions() {
+    auto load = [&](auto& function, const char* name) {
+        function = reinterpret_cast<std::remove_reference_t<decltype(function)>>(vkGetDeviceProcAddr(device_, name));
+    };
+
+    if (enabledFeatures_ & DeviceFeatureFlags::EXTENDED_DYNAMIC_STATE) {
+        load(functions_.cmdSetCullMode, "vkCmdSetCullModeEXT");
+        load(functions_.cmdSetFrontFace, "vkCmdSetFrontFaceEXT");
+        load(functions_.cmdSetPrimitiveTopology, "vkCmdSetPrimitiveTopologyEXT");
+        load(functions_.cmdSetDepthTestEnable, "vkCmdSetDepthTestEnableEXT");
+        load(functions_.cmdSetDepthWriteEnable, "vkCmdSetDepthWriteEnableEXT");
+        load(functions_.cmdSetDepthCompareOp, "vkCmdSetDepthCompareOpEXT");
+        load(functions_.cmdSetDepthBoundsTestEnable, "vkCmdSetDepthBoundsTestEnableEXT");
+        load(functions_.cmdSetStencilTestEnable, "vkCmdSetStencilTestEnableEXT");
+        load(functions_.cmdSetStencilOp, "vkCmdSetStencilOpEXT");
+    }
+
+    if (enabledFeatures_ & DeviceFeatureFlags::EXTENDED_DYNAMIC_STATE_2) {
+        load(functions_.cmdSetDepthBiasEnable, "vkCmdSetDepthBiasEnableEXT");
+        load(functions_.cmdSetPrimitiveRestartEnable, "vkCmdSetPrimitiveRestartEnableEXT");
+        load(functions_.cmdSetRasterizerDiscardEnable, "vkCmdSetRasterizerDiscardEnableEXT");
+    }
+
+    if (enabledFeatures_ & DeviceFeatureFlags::EXTENDED_DYNAMIC_STATE_3) {
+        load(functions_.cmdSetDepthClampEnable, "vkCmdSetDepthClampEnableEXT");
+        load(functions_.cmdSetColorBlendEnable, "vkCmdSetColorBlendEnableEXT");
+        load(functions_.cmdSetColorWriteMask, "vkCmdSetColorWriteMaskEXT");
+        load(functions_.cmdSetAlphaToCoverageEnable, "vkCmdSetAlphaToCoverageEnableEXT");
+    }
+
+    if (enabledFeatures_ & DeviceFeatureFlags::SYNCHRONISATION_2) {
+        load(functions_.cmdPipelineBarrier2, "vkCmdPipelineBarrier2KHR");
+    }
+
+    if (enabledFeatures_ & DeviceFeatureFlags::DYNAMIC_RENDERING) {
+        load(functions_.cmdBeginRendering, "vkCmdBeginRenderingKHR");
+        load(functions_.cmdEndRendering, "vkCmdEndRenderingKHR");
+    }
+
+    if (enabledFeatures_ & DeviceFeatureFlags::PRESENT_WAIT) {
+        load(functions_.waitForPresent, "vkWaitForPresentKHR");
+    }
+
+    if (enabledFeatures_ & DeviceFeatureFlags::BUFFER_DEVICE_ADDRESS) {
+        load(functions_.getBufferDeviceAddress, "vkGetBufferDeviceAddressKHR");
+    }
 }
\ No newline at end of file
@@ -21,6 +21,8 @@ inline void vulkanite::renderer::Fence::create(const FenceCreateInfo& createInfo
 
 inline void vulkanite::renderer::Fence::destroy() {
     if (fence_) {
+        device_->forgetFence(fence_);
+
         vkDestroyFence(device_->device_, fence_, nullptr);
 
         fence_ = nullptr;
@@ -0,0 +1,740 @@
+#pragma once
+
+#include "../command_buffer.hpp"
+#include "../device.hpp"
+#include "../frame_graph.hpp"
+#include "../image.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+
+inline void vulkanite::renderer::FrameGraph::create(const FrameGraphCreateInfo& createInfo) {
+    device_ = &createInfo.device;
+    framesInFlight_ = std::max(createInfo.framesInFlight, 1u);
+    frameIndex_ = 0;
+
+    reset();
+
+    std::uint32_t workerCount = createInfo.workerThreadCount;
+
+    if (workerCount == 0) {
+        workerCount = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+    }
+
+    startWorkers(workerCount);
+}
+
+inline void vulkanite::renderer::FrameGraph::destroy() {
+    stopWorkers();
+    reset();
+    destroyRetiredTransients(true);
+
+    device_ = nullptr;
+}
+
+inline vulkanite::renderer::FrameGraphResource vulkanite::renderer::FrameGraph::importImage(Image& image) {
+    resources_.push_back({
+        .image = &image,
+        .finalUsage = std::nullopt,
+        .transientInfo = std::nullopt,
+        .transientImage = nullptr,
+        .firstLevel = 0,
+        .lastLevel = 0,
+        .aliasPredecessor = std::nullopt,
+    });
+
+    compiled_ = false;
+
+    return static_cast<FrameGraphResource>(resources_.size() - 1);
+}
+
+inline vulkanite::renderer::FrameGraphResource vulkanite::renderer::FrameGraph::createImage(const FrameGraphImageInfo& imageInfo) {
+    auto image = std::make_unique<Image>();
+    auto* imagePointer = image.get();
+
+    resources_.push_back({
+        .image = imagePointer,
+        .finalUsage = std::nullopt,
+        .transientInfo = imageInfo,
+        .transientImage = std::move(image),
+        .firstLevel = 0,
+        .lastLevel = 0,
+        .aliasPredecessor = std::nullopt,
+    });
+
+    compiled_ = false;
+
+    return static_cast<FrameGraphResource>(resources_.size() - 1);
+}
+
+inline std::uint32_t vulkanite::renderer::FrameGraph::addPass(const FrameGraphPassInfo& passInfo) {
+    for (auto& access : passInfo.reads) {
+        if (access.resource >= resources_.size()) {
+            throw std::runtime_error("Call failed: renderer::FrameGraph::addPass(): Pass reads an unknown resource");
+        }
+    }
+
+    for (auto& access : passInfo.writes) {
+        if (access.resource >= resources_.size()) {
+            throw std::runtime_error("Call failed: renderer::FrameGraph::addPass(): Pass writes an unknown resource");
+        }
+    }
+
+    passes_.push_back({
+        .info = passInfo,
+        .level = 0,
+        .culled = false,
+    });
+
+    compiled_ = false;
+
+    return static_cast<std::uint32_t>(passes_.size() - 1);
+}
+
+inline void vulkanite::renderer::FrameGraph::markOutput(FrameGraphResource resource, ImageUsage finalUsage) {
+    if (resource >= resources_.size()) {
+        throw std::runtime_error("Call failed: renderer::FrameGraph::markOutput(): Unknown resource");
+    }
+
+    resources_[resource].finalUsage = finalUsage;
+
+    compiled_ = false;
+}
+
+inline void vulkanite::renderer::FrameGraph::compile() {
+    cullPasses();
+    schedulePasses();
+    allocateTransients();
+
+    compiled_ = true;
+}
+
+inline bool vulkanite::renderer::FrameGraph::execute(std::vector<CommandBuffer>& commandBuffers) {
+    destroyRetiredTransients(false);
+
+    if (!compiled_) {
+        compile();
+    }
+
+    if (commandBuffers.size() < schedule_.size()) {
+        throw std::runtime_error("Call failed: renderer::FrameGraph::execute(): Not enough command buffers for the scheduled passes");
+    }
+
+    if (schedule_.empty()) {
+        return true;
+    }
+
+    bool success = true;
+
+    frameIndex_++;
+
+    // transients keep their memory across frames, so the first user of each block must wait on last frame's accesses to it
+    std::vector<Image::SubresourceState> carried(resources_.size(), {
+        .layout = VK_IMAGE_LAYOUT_UNDEFINED,
+        .stages = 0,
+        .access = 0,
+    });
+
+    for (std::uint64_t i = 0; i < resources_.size(); i++) {
+        auto& resource = resources_[i];
+
+        if (!resource.transientInfo || !resource.image->image_ || !resource.image->subresourceStates_) {
+            continue;
+        }
+
+        std::uint64_t head = i;
+
+        while (resources_[head].aliasPredecessor) {
+            head = resources_[head].aliasPredecessor.value();
+        }
+
+        for (auto& state : *resource.image->subresourceStates_) {
+            carried[head].stages |= state.stages;
+            carried[head].access |= state.access;
+        }
+    }
+
+    std::vector<bool> lifetimeStarted(resources_.size(), false);
+
+    auto beginLifetime = [&](FrameGraphResource resourceIndex) {
+        auto& resource = resources_[resourceIndex];
+
+        if (!resource.transientInfo || lifetimeStarted[resourceIndex]) {
+            return;
+        }
+
+        lifetimeStarted[resourceIndex] = true;
+
+        Image::SubresourceState handoff = carried[resourceIndex];
+
+        if (resource.aliasPredecessor) {
+            for (auto& state : *resources_[resource.aliasPredecessor.value()].image->subresourceStates_) {
+                handoff.stages |= state.stages;
+                handoff.access |= state.access;
+            }
+        }
+
+        for (auto& state : *resource.image->subresourceStates_) {
+            state = handoff;
+        }
+    };
+
+    for (std::uint64_t i = 0; i < schedule_.size(); i++) {
+        auto& commandBuffer = commandBuffers[i];
+        auto& pass = passes_[schedule_[i]];
+
+        success &= commandBuffer.beginCapture();
+
+        for (auto& access : pass.info.reads) {
+            beginLifetime(access.resource);
+
+            commandBuffer.requireState(*resources_[access.resource].image, access.usage);
+        }
+
+        for (auto& access : pass.info.writes) {
+            beginLifetime(access.resource);
+
+            commandBuffer.requireState(*resources_[access.resource].image, access.usage);
+        }
+    }
+
+    // command buffers sharing a pool must never record concurrently, so each pool's passes form one serial group
+    std::vector<CommandPool*> groupPools;
+    std::vector<std::vector<std::uint64_t>> groups;
+
+    for (std::uint64_t i = 0; i < schedule_.size(); i++) {
+        auto pool = std::find(groupPools.begin(), groupPools.end(), commandBuffers[i].commandPool_);
+
+        if (pool == groupPools.end()) {
+            groupPools.push_back(commandBuffers[i].commandPool_);
+            groups.emplace_back();
+
+            pool = groupPools.end() - 1;
+        }
+
+        groups[pool - groupPools.begin()].push_back(i);
+    }
+
+    std::atomic<std::uint64_t> nextGroup = 0;
+
+    auto recordPasses = [&]() {
+        for (std::uint64_t group = nextGroup.fetch_add(1); group < groups.size(); group = nextGroup.fetch_add(1)) {
+            for (std::uint64_t i : groups[group]) {
+                auto& commandBuffer = commandBuffers[i];
+                auto& pass = passes_[schedule_[i]];
+
+                commandBuffer.flushBarriers();
+
+                if (pass.info.record) {
+                    pass.info.record(commandBuffer);
+                }
+            }
+        }
+    };
+
+    if (groups.size() > 1) {
+        runOnWorkers(recordPasses);
+    }
+    else {
+        recordPasses();
+    }
+
+    auto& lastCommandBuffer = commandBuffers[schedule_.size() - 1];
+
+    for (auto& resource : resources_) {
+        if (resource.finalUsage) {
+            lastCommandBuffer.requireState(*resource.image, resource.finalUsage.value());
+        }
+    }
+
+    for (std::uint64_t i = 0; i < schedule_.size(); i++) {
+        success &= commandBuffers[i].endCapture();
+    }
+
+    return success;
+}
+
+inline void vulkanite::renderer::FrameGraph::reset() {
+    releaseTransients();
+
+    passes_.clear();
+    resources_.clear();
+    schedule_.clear();
+
+    levelCount_ = 0;
+    compiled_ = false;
+}
+
+inline const std::vector<std::uint32_t>& vulkanite::renderer::FrameGraph::getSchedule() const {
+    return schedule_;
+}
+
+inline std::uint32_t vulkanite::renderer::FrameGraph::getLevelCount() const {
+    return levelCount_;
+}
+
+inline bool vulkanite::renderer::FrameGraph::isPassCulled(std::uint32_t pass) const {
+    return pass >= passes_.size() || passes_[pass].culled;
+}
+
+inline vulkanite::renderer::Image& vulkanite::renderer::FrameGraph::getImage(FrameGraphResource resource) {
+    if (resource >= resources_.size()) {
+        throw std::runtime_error("Call failed: renderer::FrameGraph::getImage(): Unknown resource");
+    }
+
+    return *resources_[resource].image;
+}
+
+inline std::uint64_t vulkanite::renderer::FrameGraph::getTransientMemorySize() const {
+    return transientMemorySize_;
+}
+
+inline void vulkanite::renderer::FrameGraph::cullPasses() {
+    std::vector<bool> needed(resources_.size(), false);
+
+    for (std::uint64_t i = 0; i < resources_.size(); i++) {
+        needed[i] = resources_[i].finalUsage.has_value();
+    }
+
+    for (std::uint64_t i = passes_.size(); i > 0; i--) {
+        auto& pass = passes_[i - 1];
+
+        bool live = pass.info.hasSideEffects;
+
+        for (auto& access : pass.info.writes) {
+            live = live || needed[access.resource];
+        }
+
+        pass.culled = !live;
+
+        if (!live) {
+            continue;
+        }
+
+        for (auto& access : pass.info.writes) {
+            needed[access.resource] = false;
+        }
+
+        for (auto& access : pass.info.reads) {
+            needed[access.resource] = true;
+        }
+    }
+}
+
+inline void vulkanite::renderer::FrameGraph::schedulePasses() {
+    schedule_.clear();
+    levelCount_ = 0;
+
+    for (std::uint64_t i = 0; i < passes_.size(); i++) {
+        auto& pass = passes_[i];
+
+        if (pass.culled) {
+            continue;
+        }
+
+        pass.level = 0;
+
+        for (std::uint64_t j = 0; j < i; j++) {
+            auto& earlier = passes_[j];
+
+            if (!earlier.culled && conflicts(earlier, pass)) {
+                pass.level = std::max(pass.level, earlier.level + 1);
+            }
+        }
+
+        levelCount_ = std::max(levelCount_, pass.level + 1);
+
+        schedule_.push_back(static_cast<std::uint32_t>(i));
+    }
+
+    std::stable_sort(schedule_.begin(), schedule_.end(), [&](std::uint32_t a, std::uint32_t b) {
+        return passes_[a].level < passes_[b].level;
+    });
+}
+
+inline void vulkanite::renderer::FrameGraph::allocateTransients() {
+    releaseTransients();
+
+    std::vector<bool> used(resources_.size(), false);
+
+    for (auto passIndex : schedule_) {
+        auto& pass = passes_[passIndex];
+
+        auto markUsed = [&](const std::vector<FrameGraphResourceAccess>& accesses) {
+            for (auto& access : accesses) {
+                auto& resource = resources_[access.resource];
+
+                if (!used[access.resource]) {
+                    resource.firstLevel = pass.level;
+                    used[access.resource] = true;
+                }
+
+                resource.lastLevel = pass.level;
+            }
+        };
+
+        markUsed(pass.info.reads);
+        markUsed(pass.info.writes);
+    }
+
+    for (auto& resource : resources_) {
+        if (resource.finalUsage) {
+            resource.lastLevel = levelCount_;
+        }
+    }
+
+    std::vector<VkMemoryRequirements> requirements(resources_.size());
+    std::vector<FrameGraphResource> candidates;
+
+    for (std::uint64_t i = 0; i < resources_.size(); i++) {
+        auto& resource = resources_[i];
+
+        resource.aliasPredecessor = std::nullopt;
+
+        if (!resource.transientInfo || !used[i]) {
+            continue;
+        }
+
+        auto& imageInfo = resource.transientInfo.value();
+        auto& image = *resource.transientImage;
+
+        VkImageCreateInfo imageCreateInfo = {
+            .sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+            .pNext = nullptr,
+            .flags = 0,
+            .imageType = Image::mapType(imageInfo.type),
+            .format = Image::mapFormat(imageInfo.format, *device_->instance_),
+            .extent = {imageInfo.extent.x, imageInfo.extent.y, imageInfo.extent.z},
+            .mipLevels = imageInfo.mipLevels,
+            .arrayLayers = imageInfo.arrayLayers,
+            .samples = static_cast<VkSampleCountFlagBits>(imageInfo.sampleCount),
+            .tiling = VK_IMAGE_TILING_OPTIMAL,
+            .usage = ImageUsageFlags::mapFrom(imageInfo.usageFlags),
+            .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+            .queueFamilyIndexCount = 0,
+            .pQueueFamilyIndices = nullptr,
+            .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+        };
+
+        if (imageInfo.memoryType == MemoryType::LAZILY_ALLOCATED) {
+            imageCreateInfo.usage |= VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT;
+        }
+
+        if (vkCreateImage(device_->device_, &imageCreateInfo, nullptr, &image.image_) != VK_SUCCESS) {
+            image.image_ = nullptr;
+
+            throw std::runtime_error("Call failed: renderer::FrameGraph::compile(): Failed to create transient image");
+        }
+
+        vkGetImageMemoryRequirements(device_->device_, image.image_, &requirements[i]);
+
+        image.allocation_ = nullptr;
+        image.device_ = device_;
+        image.extent_ = imageInfo.extent;
+        image.sampleCount_ = imageInfo.sampleCount;
+        image.mipLevels_ = imageInfo.mipLevels;
+        image.arrayLayers_ = imageInfo.arrayLayers;
+        image.type_ = imageCreateInfo.imageType;
+        image.format_ = imageCreateInfo.format;
+        image.isHostVisible_ = false;
+        image.isHostCoherent_ = false;
+        image.size_ = requirements[i].size;
+
+        image.initialiseSubresourceStates(0);
+
+        if (imageInfo.memoryType == MemoryType::LAZILY_ALLOCATED) {
+            VmaAllocationCreateInfo allocationCreateInfo = {
+                .flags = 0,
+                .usage = VMA_MEMORY_USAGE_GPU_LAZILY_ALLOCATED,
+                .requiredFlags = 0,
+                .preferredFlags = VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT,
+                .memoryTypeBits = 0,
+                .pool = nullptr,
+                .pUserData = nullptr,
+                .priority = 0.5,
+            };
+
+            VmaAllocation allocation = nullptr;
+
+            if (vmaAllocateMemory(device_->allocator_, &requirements[i], &allocationCreateInfo, &allocation, nullptr) == VK_SUCCESS) {
+                transientAllocations_.push_back(allocation);
+                transientMemorySize_ += requirements[i].size;
+
+                vmaBindImageMemory(device_->allocator_, allocation, image.image_);
+
+                continue;
+            }
+        }
+
+        candidates.push_back(static_cast<FrameGraphResource>(i));
+    }
+
+    std::stable_sort(candidates.begin(), candidates.end(), [&](FrameGraphResource a, FrameGraphResource b) {
+        return requirements[a].size > requirements[b].size;
+    });
+
+    std::vector<TransientBlock> blocks;
+
+    for (auto candidate : candidates) {
+        auto& resource = resources_[candidate];
+        auto& candidateRequirements = requirements[candidate];
+
+        MemoryType memoryType = resource.transientInfo->memoryType == MemoryType::HOST_VISIBLE ? MemoryType::HOST_VISIBLE : MemoryType::DEVICE_LOCAL;
+
+        TransientBlock* bestBlock = nullptr;
+
+        for (auto& block : blocks) {
+            if (block.memoryType != memoryType || (block.requirements.memoryTypeBits & candidateRequirements.memoryTypeBits) == 0) {
+                continue;
+            }
+
+            bool overlaps = false;
+
+            for (auto other : block.resources) {
+                auto& otherResource = resources_[other];
+
+                if (otherResource.firstLevel <= resource.lastLevel && resource.firstLevel <= otherResource.lastLevel) {
+                    overlaps = true;
+                    break;
+                }
+            }
+
+            if (!overlaps && (!bestBlock || block.requirements.size < bestBlock->requirements.size)) {
+                bestBlock = &block;
+            }
+        }
+
+        if (!bestBlock) {
+            blocks.push_back({
+                .memoryType = memoryType,
+                .requirements = candidateRequirements,
+                .resources = {},
+            });
+
+            bestBlock = &blocks.back();
+        }
+        else {
+            auto& blockRequirements = bestBlock->requirements;
+
+            blockRequirements.size = std::max(blockRequirements.size, candidateRequirements.size);
+            blockRequirements.alignment = std::max(blockRequirements.alignment, candidateRequirements.alignment);
+            blockRequirements.memoryTypeBits &= candidateRequirements.memoryTypeBits;
+        }
+
+        bestBlock->resources.push_back(candidate);
+    }
+
+    for (auto& block : blocks) {
+        VmaAllocationCreateInfo allocationCreateInfo = {
+            .flags = 0,
+            .usage = block.memoryType == MemoryType::HOST_VISIBLE ? VMA_MEMORY_USAGE_CPU_TO_GPU : VMA_MEMORY_USAGE_GPU_ONLY,
+            .requiredFlags = 0,
+            .preferredFlags = block.memoryType == MemoryType::HOST_VISIBLE ? VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT : VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+            .memoryTypeBits = 0,
+            .pool = nullptr,
+            .pUserData = nullptr,
+            .priority = 0.5,
+        };
+
+        VmaAllocation allocation = nullptr;
+
+        if (vmaAllocateMemory(device_->allocator_, &block.requirements, &allocationCreateInfo, &allocation, nullptr) != VK_SUCCESS) {
+            throw std::runtime_error("Call failed: renderer::FrameGraph::compile(): Failed to allocate transient memory");
+        }
+
+        transientAllocations_.push_back(allocation);
+        transientMemorySize_ += block.requirements.size;
+
+        std::stable_sort(block.resources.begin(), block.resources.end(), [&](FrameGraphResource a, FrameGraphResource b) {
+            return resources_[a].firstLevel < resources_[b].firstLevel;
+        });
+
+        for (std::uint64_t i = 0; i < block.resources.size(); i++) {
+            auto& resource = resources_[block.resources[i]];
+
+            if (i > 0) {
+                resource.aliasPredecessor = block.resources[i - 1];
+            }
+
+            vmaBindImageMemory(device_->allocator_, allocation, resource.image->image_);
+        }
+    }
+}
+
+inline void vulkanite::renderer::FrameGraph::releaseTransients() {
+    RetiredTransients retired = {
+        .frame = frameIndex_,
+        .images = {},
+        .allocations = std::move(transientAllocations_),
+    };
+
+    for (auto& resource : resources_) {
+        if (resource.transientImage && resource.transientImage->image_) {
+            retired.images.push_back(resource.transientImage->image_);
+
+            resource.transientImage->image_ = nullptr;
+            resource.transientImage->subresourceStates_.reset();
+        }
+    }
+
+    if (!retired.images.empty() || !retired.allocations.empty()) {
+        retiredTransients_.push_back(std::move(retired));
+    }
+
+    transientAllocations_.clear();
+    transientMemorySize_ = 0;
+}
+
+inline void vulkanite::renderer::FrameGraph::destroyRetiredTransients(bool waitedIdle) {
+    // a release recorded at frame F was last used by frame F, which has completed once framesInFlight_ more frames have begun
+    std::erase_if(retiredTransients_, [&](RetiredTransients& retired) {
+        if (!waitedIdle && retired.frame + framesInFlight_ > frameIndex_) {
+            return false;
+        }
+
+        for (VkImage image : retired.images) {
+            vkDestroyImage(device_->device_, image, nullptr);
+        }
+
+        for (VmaAllocation allocation : retired.allocations) {
+            vmaFreeMemory(device_->allocator_, allocation);
+        }
+
+        return true;
+    });
+}
+
+inline bool vulkanite::renderer::FrameGraph::conflicts(const Pass& first, const Pass& second) {
+    auto overlaps = [](const std::vector<FrameGraphResourceAccess>& accesses, const std::vector<FrameGraphResourceAccess>& others, bool requireMatchingUsage) {
+        for (auto& access : accesses) {
+            for (auto& other : others) {
+                if (access.resource != other.resource) {
+                    continue;
+                }
+
+                if (!requireMatchingUsage || access.usage != other.usage) {
+                    return true;
+                }
+            }
+        }
+
+        return false;
+    };
+
+    return overlaps(first.info.writes, second.info.reads, false) ||
+           overlaps(first.info.writes, second.info.writes, false) ||
+           overlaps(first.info.reads, second.info.writes, false) ||
+           overlaps(first.info.reads, second.info.reads, true);
+}
+
+inline void vulkanite::renderer::FrameGraph::startWorkers(std::uint32_t workerCount) {
+    stopWorkers();
+
+    workerPool_ = std::make_unique<WorkerPool>();
+    workerPool_->threads.reserve(workerCount);
+
+    for (std::uint32_t i = 0; i < workerCount; i++) {
+        workerPool_->threads.emplace_back(workerLoop, std::ref(*workerPool_));
+    }
+}
+
+inline void vulkanite::renderer::FrameGraph::stopWorkers() {
+    if (!workerPool_) {
+        return;
+    }
+
+    {
+        std::lock_guard lock(workerPool_->mutex);
+
+        workerPool_->stopping = true;
+    }
+
+    workerPool_->wake.notify_all();
+
+    for (auto& thread : workerPool_->threads) {
+        thread.join();
+    }
+
+    workerPool_.reset();
+}
+
+inline void vulkanite::renderer::FrameGraph::runOnWorkers(const std::function<void()>& task) {
+    if (!workerPool_ || workerPool_->threads.empty()) {
+        task();
+
+        return;
+    }
+
+    auto& pool = *workerPool_;
+
+    {
+        std::lock_guard lock(pool.mutex);
+
+        pool.task = task;
+        pool.error = nullptr;
+        pool.pending = pool.threads.size();
+        pool.generation++;
+    }
+
+    pool.wake.notify_all();
+
+    std::exception_ptr error;
+
+    try {
+        task();
+    }
+    catch (...) {
+        error = std::current_exception();
+    }
+
+    {
+        std::unique_lock lock(pool.mutex);
+
+        pool.idle.wait(lock, [&]() { return pool.pending == 0; });
+        pool.task = nullptr;
+
+        if (!error) {
+            error = pool.error;
+        }
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+inline void vulkanite::renderer::FrameGraph::workerLoop(WorkerPool& pool) {
+    std::uint64_t generation = 0;
+
+    while (true) {
+        {
+            std::unique_lock lock(pool.mutex);
+
+            pool.wake.wait(lock, [&]() { return pool.stopping || pool.generation != generation; });
+
+            if (pool.stopping) {
+                return;
+            }
+
+            generation = pool.generation;
+        }
+
+        try {
+            pool.task();
+        }
+        catch (...) {
+            std::lock_guard lock(pool.mutex);
+
+            if (!pool.error) {
+                pool.error = std::current_exception();
+            }
+        }
+
+        std::lock_guard lock(pool.mutex);
+
+        if (--pool.pending == 0) {
+            pool.idle.notify_one();
+        }
+    }
+}
\ No newline at end of file
@@ -6,6 +6,9 @@
 #include "../image_view.hpp"
 #include "../render_pass.hpp"
 
+#include <algorithm>
+#include <stdexcept>
+
 inline void vulkanite::renderer::Framebuffer::create(const FramebufferCreateInfo& createInfo) {
     std::vector<VkImageView> imageViews;
 
@@ -43,4 +46,106 @@ inline void vulkanite::renderer::Framebuffer::destroy() {
 
         framebuffer_ = nullptr;
     }
+}
+
+inline void vulkanite::renderer::FramebufferCache::create(const FramebufferCacheCreateInfo& createInfo) {
+    device_ = &createInfo.device;
+
+    std::lock_guard<std::mutex> lock(device_->framebufferCacheMutex_);
+
+    device_->framebufferCaches_.push_back(this);
+}
+
+inline void vulkanite::renderer::FramebufferCache::destroy() {
+    if (!device_) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(device_->framebufferCacheMutex_);
+
+        auto& caches = device_->framebufferCaches_;
+
+        caches.erase(std::remove(caches.begin(), caches.end(), this), caches.end());
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    for (auto& [key, framebuffer] : framebuffers_) {
+        framebuffer.destroy();
+    }
+
+    framebuffers_.clear();
+
+    device_ = nullptr;
+}
+
+inline vulkanite::renderer::Framebuffer vulkanite::renderer::FramebufferCache::getFramebuffer(RenderPass& renderPass, const std::vector<ImageView>& imageViews) {
+    if (imageViews.empty()) {
+        throw std::runtime_error("Call failed: renderer::FramebufferCache::getFramebuffer(): Framebuffers require at least one image view");
+    }
+
+    auto& defactoImage = imageViews.front();
+
+    std::vector<std::uint64_t> key;
+
+    key.reserve(imageViews.size() + 3);
+    key.push_back(static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(renderPass.renderPass_)));
+    key.push_back(defactoImage.extent_.x);
+    key.push_back(defactoImage.extent_.y);
+
+    for (auto& imageView : imageViews) {
+        key.push_back(static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(imageView.imageView_)));
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto iterator = framebuffers_.find(key);
+
+    if (iterator != framebuffers_.end()) {
+        return iterator->second;
+    }
+
+    FramebufferCreateInfo framebufferCreateInfo = {
+        .device = *device_,
+        .renderPass = renderPass,
+        .imageViews = imageViews,
+    };
+
+    Framebuffer framebuffer;
+
+    framebuffer.create(framebufferCreateInfo);
+
+    if (!framebuffer.framebuffer_) {
+        throw std::runtime_error("Call failed: renderer::FramebufferCache::getFramebuffer(): Failed to create framebuffer");
+    }
+
+    framebuffers_.emplace(std::move(key), framebuffer);
+
+    return framebuffer;
+}
+
+inline std::uint32_t vulkanite::renderer::FramebufferCache::getFramebufferCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    return static_cast<std::uint32_t>(framebuffers_.size());
+}
+
+inline void vulkanite::renderer::FramebufferCache::evict(std::uint64_t handle) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    for (auto iterator = framebuffers_.begin(); iterator != framebuffers_.end();) {
+        auto& key = iterator->first;
+
+        bool matchesRenderPass = key[0] == handle;
+        bool matchesImageView = std::find(key.begin() + 3, key.end(), handle) != key.end();
+
+        if (matchesRenderPass || matchesImageView) {
+            iterator->second.destroy();
+            iterator = framebuffers_.erase(iterator);
+        }
+        else {
+            iterator++;
+        }
+    }
 }
\ No newline at end of file
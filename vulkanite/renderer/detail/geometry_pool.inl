@@ -0,0 +1,138 @@
+#pragma once
+
+#include "../buffer.hpp"
+#include "../command_buffer.hpp"
+#include "../device.hpp"
+#include "../geometry_pool.hpp"
+
+#include <stdexcept>
+
+inline void vulkanite::renderer::GeometryPool::create(const GeometryPoolCreateInfo& createInfo) {
+    if (createInfo.vertexStride == 0 || createInfo.vertexCapacity == 0 || createInfo.indexCapacity == 0) {
+        throw std::runtime_error("Construction failed: renderer::GeometryPool: Stride and capacities must be non-zero");
+    }
+
+    indexType_ = createInfo.indexType;
+    vertexStride_ = createInfo.vertexStride;
+    indexSize_ = createInfo.indexType == IndexType::UINT16 ? 2 : 4;
+
+    BufferCreateInfo vertexBufferCreateInfo = {
+        .device = createInfo.device,
+        .memoryType = MemoryType::DEVICE_LOCAL,
+        .usageFlags = createInfo.usageFlags | BufferUsageFlags::VERTEX | BufferUsageFlags::TRANSFER_SOURCE | BufferUsageFlags::TRANSFER_DESTINATION,
+        .sizeBytes = static_cast<std::uint64_t>(createInfo.vertexCapacity) * vertexStride_,
+    };
+
+    BufferCreateInfo indexBufferCreateInfo = {
+        .device = createInfo.device,
+        .memoryType = MemoryType::DEVICE_LOCAL,
+        .usageFlags = createInfo.usageFlags | BufferUsageFlags::INDEX | BufferUsageFlags::TRANSFER_SOURCE | BufferUsageFlags::TRANSFER_DESTINATION,
+        .sizeBytes = static_cast<std::uint64_t>(createInfo.indexCapacity) * indexSize_,
+    };
+
+    vertexBuffer_.create(vertexBufferCreateInfo);
+    indexBuffer_.create(indexBufferCreateInfo);
+
+    if (!vertexBuffer_ || !indexBuffer_) {
+        vertexBuffer_.destroy();
+        indexBuffer_.destroy();
+
+        throw std::runtime_error("Construction failed: renderer::GeometryPool: Failed to create geometry buffers");
+    }
+
+    vertexRanges_.create(createInfo.vertexCapacity);
+    indexRanges_.create(createInfo.indexCapacity);
+}
+
+inline void vulkanite::renderer::GeometryPool::destroy() {
+    vertexBuffer_.destroy();
+    indexBuffer_.destroy();
+
+    vertexRanges_.destroy();
+    indexRanges_.destroy();
+}
+
+inline std::optional<vulkanite::renderer::GeometryAllocation> vulkanite::renderer::GeometryPool::allocate(std::uint32_t vertexCount, std::uint32_t indexCount) {
+    if (vertexCount == 0) {
+        return std::nullopt;
+    }
+
+    auto firstVertex = vertexRanges_.allocate(vertexCount);
+
+    if (!firstVertex) {
+        return std::nullopt;
+    }
+
+    std::optional<std::uint32_t> firstIndex = 0;
+
+    if (indexCount > 0) {
+        firstIndex = indexRanges_.allocate(indexCount);
+
+        if (!firstIndex) {
+            vertexRanges_.free(firstVertex.value(), vertexCount);
+
+            return std::nullopt;
+        }
+    }
+
+    return GeometryAllocation{
+        .firstVertex = firstVertex.value(),
+        .vertexCount = vertexCount,
+        .firstIndex = firstIndex.value(),
+        .indexCount = indexCount,
+        .vertexOffset = static_cast<std::int32_t>(firstVertex.value()),
+        .vertexOffsetBytes = static_cast<std::uint64_t>(firstVertex.value()) * vertexStride_,
+        .indexOffsetBytes = static_cast<std::uint64_t>(firstIndex.value()) * indexSize_,
+    };
+}
+
+inline void vulkanite::renderer::GeometryPool::free(const GeometryAllocation& allocation) {
+    // validate both ranges first so a bad allocation leaves the pool untouched
+    if (!vertexRanges_.isAllocated(allocation.firstVertex, allocation.vertexCount)) {
+        throw std::runtime_error("Call failed: renderer::GeometryPool::free(): Vertex range is outside the pool or already free");
+    }
+
+    if (allocation.indexCount > 0 && !indexRanges_.isAllocated(allocation.firstIndex, allocation.indexCount)) {
+        throw std::runtime_error("Call failed: renderer::GeometryPool::free(): Index range is outside the pool or already free");
+    }
+
+    vertexRanges_.free(allocation.firstVertex, allocation.vertexCount);
+    indexRanges_.free(allocation.firstIndex, allocation.indexCount);
+}
+
+inline void vulkanite::renderer::GeometryPool::bind(CommandBuffer& commandBuffer) {
+    commandBuffer.bindVertexBuffers({vertexBuffer_}, {0}, 0);
+    commandBuffer.bindIndexBuffer(indexBuffer_, 0, indexType_);
+}
+
+inline vulkanite::renderer::Buffer& vulkanite::renderer::GeometryPool::getVertexBuffer() {
+    return vertexBuffer_;
+}
+
+inline vulkanite::renderer::Buffer& vulkanite::renderer::GeometryPool::getIndexBuffer() {
+    return indexBuffer_;
+}
+
+inline vulkanite::renderer::IndexType vulkanite::renderer::GeometryPool::getIndexType() const {
+    return indexType_;
+}
+
+inline std::uint32_t vulkanite::renderer::GeometryPool::getVertexStride() const {
+    return vertexStride_;
+}
+
+inline std::uint32_t vulkanite::renderer::GeometryPool::getUsedVertexCount() const {
+    return vertexRanges_.getUsedCount();
+}
+
+inline std::uint32_t vulkanite::renderer::GeometryPool::getUsedIndexCount() const {
+    return indexRanges_.getUsedCount();
+}
+
+inline std::uint32_t vulkanite::renderer::GeometryPool::getLargestFreeVertexRange() const {
+    return vertexRanges_.getLargestFreeRange();
+}
+
+inline std::uint32_t vulkanite::renderer::GeometryPool::getLargestFreeIndexRange() const {
+    return indexRanges_.getLargestFreeRange();
+}
\ No newline at end of file
@@ -3,7 +3,9 @@
 #include "../device.hpp"
 #include "../image.hpp"
 #include "../instance.hpp"
+#include "../memory_pool.hpp"
 
+#include <algorithm>
 #include <stdexcept>
 
 inline void vulkanite::renderer::Image::create(const ImageCreateInfo& createInfo) {
@@ -20,17 +22,42 @@ inline void vulkanite::renderer::Image::create(const ImageCreateInfo& createInfo
             memoryUsage = VMA_MEMORY_USAGE_CPU_TO_GPU;
             memoryProperties = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
             break;
+
+        case MemoryType::LAZILY_ALLOCATED:
+            memoryUsage = VMA_MEMORY_USAGE_GPU_LAZILY_ALLOCATED;
+            memoryProperties = VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT;
+            break;
+
+        case MemoryType::DEVICE_LOCAL_HOST_VISIBLE:
+            memoryUsage = VMA_MEMORY_USAGE_GPU_ONLY;
+            memoryProperties = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT;
+            break;
+
+        case MemoryType::HOST_CACHED:
+            memoryUsage = VMA_MEMORY_USAGE_GPU_TO_CPU;
+            memoryProperties = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_CACHED_BIT;
+            break;
+    }
+
+    if (createInfo.priority < 0.0f || createInfo.priority > 1.0f) {
+        throw std::runtime_error("Construction failed: renderer::Image: Priority must be between 0 and 1");
+    }
+
+    VmaAllocationCreateFlags allocationFlags = 0;
+
+    if (createInfo.dedicatedAllocation) {
+        allocationFlags |= VMA_ALLOCATION_CREATE_DEDICATED_MEMORY_BIT;
     }
 
     VmaAllocationCreateInfo allocationCreateInfo = {
-        .flags = 0,
+        .flags = allocationFlags,
         .usage = memoryUsage,
         .requiredFlags = 0,
         .preferredFlags = memoryProperties,
         .memoryTypeBits = 0,
-        .pool = nullptr,
+        .pool = createInfo.pool ? createInfo.pool->pool_ : nullptr,
         .pUserData = nullptr,
-        .priority = 0.0,
+        .priority = createInfo.priority,
     };
 
     VkImageCreateInfo imageCreateInfo = {
@@ -51,9 +78,22 @@ inline void vulkanite::renderer::Image::create(const ImageCreateInfo& createInfo
         .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED,
     };
 
+    if (createInfo.memoryType == MemoryType::LAZILY_ALLOCATED) {
+        imageCreateInfo.usage |= VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT;
+    }
+
     VmaAllocationInfo allocationInfo = {};
 
-    if (vmaCreateImage(createInfo.device.allocator_, &imageCreateInfo, &allocationCreateInfo, &image_, &allocation_, &allocationInfo) != VK_SUCCESS) {
+    VkResult result = vmaCreateImage(createInfo.device.allocator_, &imageCreateInfo, &allocationCreateInfo, &image_, &allocation_, &allocationInfo);
+
+    if (result != VK_SUCCESS && createInfo.memoryType == MemoryType::LAZILY_ALLOCATED) {
+        allocationCreateInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
+        allocationCreateInfo.preferredFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+
+        result = vmaCreateImage(createInfo.device.allocator_, &imageCreateInfo, &allocationCreateInfo, &image_, &allocation_, &allocationInfo);
+    }
+
+    if (result != VK_SUCCESS) {
         image_ = nullptr;
         allocation_ = nullptr;
     }
@@ -75,13 +115,21 @@ inline void vulkanite::renderer::Image::create(const ImageCreateInfo& createInfo
         type_ = imageCreateInfo.imageType;
         extent_ = createInfo.extent;
         format_ = imageCreateInfo.format;
+        usage_ = imageCreateInfo.usage;
+
+        initialiseSubresourceStates(0);
     }
 }
 
 inline void vulkanite::renderer::Image::destroy() {
     if (image_) {
         vmaDestroyImage(device_->allocator_, image_, allocation_);
+
+        image_ = nullptr;
+        allocation_ = nullptr;
     }
+
+    subresourceStates_.reset();
 }
 
 inline vulkanite::renderer::ImageMapping vulkanite::renderer::Image::map(std::uint64_t sizeBytes, std::uint64_t offsetBytes) {
@@ -96,9 +144,7 @@ inline vulkanite::renderer::ImageMapping vulkanite::renderer::Image::map(std::ui
         VkDeviceSize atomSize = properties.limits.nonCoherentAtomSize;
 
         mapping.alignedOffset = offsetBytes & ~(atomSize - 1);
-        mapping.alignedSize = ((mapping.alignedOffset + sizeBytes + atomSize - 1) & ~(atomSize - 1)) - mapping.alignedOffset;
-
-        vmaInvalidateAllocation(device_->allocator_, allocation_, mapping.alignedOffset, mapping.alignedSize);
+        mapping.alignedSize = std::min((offsetBytes + sizeBytes + atomSize - 1) & ~(atomSize - 1), size_) - mapping.alignedOffset;
     }
     else {
         mapping.alignedOffset = offsetBytes;
@@ -109,6 +155,10 @@ inline vulkanite::renderer::ImageMapping vulkanite::renderer::Image::map(std::ui
 
     vmaMapMemory(device_->allocator_, allocation_, &data);
 
+    if (!isHostCoherent_) {
+        vmaInvalidateAllocation(device_->allocator_, allocation_, mapping.alignedOffset, mapping.alignedSize);
+    }
+
     mapping.data = {reinterpret_cast<std::uint8_t*>(data) + offsetBytes, sizeBytes};
 
     return mapping;
@@ -154,6 +204,31 @@ inline std::uint32_t vulkanite::renderer::Image::getArrayLayers() const {
     return arrayLayers_;
 }
 
+inline vulkanite::renderer::ImageLayout vulkanite::renderer::Image::getLayout(std::uint32_t mipLevel, std::uint32_t arrayLayer) const {
+    if (!subresourceStates_ || mipLevel >= mipLevels_ || arrayLayer >= arrayLayers_) {
+        return ImageLayout::UNDEFINED;
+    }
+
+    return reverseMapLayout((*subresourceStates_)[mipLevel * arrayLayers_ + arrayLayer].layout);
+}
+
+inline void vulkanite::renderer::Image::initialiseSubresourceStates(VkPipelineStageFlags stages) {
+    SubresourceState initialState = {
+        .layout = VK_IMAGE_LAYOUT_UNDEFINED,
+        .stages = stages,
+        .access = 0,
+    };
+
+    subresourceStates_ = std::make_shared<std::vector<SubresourceState>>(static_cast<std::uint64_t>(mipLevels_) * arrayLayers_, initialState);
+}
+
+inline bool vulkanite::renderer::Image::containsRange(const ImageSubresourceRange& range) const {
+    std::uint64_t mipLevelEnd = static_cast<std::uint64_t>(range.baseMipLevel) + range.mipLevelCount;
+    std::uint64_t arrayLayerEnd = static_cast<std::uint64_t>(range.baseArrayLayer) + range.arrayLayerCount;
+
+    return range.mipLevelCount > 0 && range.arrayLayerCount > 0 && mipLevelEnd <= mipLevels_ && arrayLayerEnd <= arrayLayers_;
+}
+
 inline VkFormat vulkanite::renderer::Image::mapFormat(ImageFormat format, Instance& instance) {
     auto findSupportedFormat = [&](const std::vector<VkFormat>& candidates, VkImageTiling tiling, VkFormatFeatureFlags features) -> VkFormat {
         for (VkFormat vkFormat : candidates) {
@@ -305,4 +380,135 @@ inline vulkanite::renderer::ImageType vulkanite::renderer::Image::reverseMapType
         default:
             return ImageType::IMAGE_1D;
     }
+}
+
+inline VkImageLayout vulkanite::renderer::Image::mapLayout(ImageLayout layout) {
+    switch (layout) {
+        case ImageLayout::UNDEFINED:
+            return VK_IMAGE_LAYOUT_UNDEFINED;
+
+        case ImageLayout::PREINITIALIZED:
+            return VK_IMAGE_LAYOUT_PREINITIALIZED;
+
+        case ImageLayout::COLOR_ATTACHMENT_OPTIMAL:
+            return VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+
+        case ImageLayout::DEPTH_STENCIL_ATTACHMENT_OPTIMAL:
+            return VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+
+        case ImageLayout::DEPTH_STENCIL_READ_ONLY_OPTIMAL:
+            return VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
+
+        case ImageLayout::SHADER_READ_ONLY_OPTIMAL:
+            return VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+        case ImageLayout::TRANSFER_SOURCE_OPTIMAL:
+            return VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+
+        case ImageLayout::TRANSFER_DESTINATION_OPTIMAL:
+            return VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+
+        case ImageLayout::GENERAL:
+            return VK_IMAGE_LAYOUT_GENERAL;
+
+        case ImageLayout::PRESENT_SOURCE:
+            return VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+
+        default:
+            return VK_IMAGE_LAYOUT_UNDEFINED;
+    }
+}
+
+inline vulkanite::renderer::ImageLayout vulkanite::renderer::Image::reverseMapLayout(VkImageLayout layout) {
+    switch (layout) {
+        case VK_IMAGE_LAYOUT_PREINITIALIZED:
+            return ImageLayout::PREINITIALIZED;
+
+        case VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL:
+            return ImageLayout::COLOR_ATTACHMENT_OPTIMAL;
+
+        case VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL:
+            return ImageLayout::DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+
+        case VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL:
+            return ImageLayout::DEPTH_STENCIL_READ_ONLY_OPTIMAL;
+
+        case VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL:
+            return ImageLayout::SHADER_READ_ONLY_OPTIMAL;
+
+        case VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL:
+            return ImageLayout::TRANSFER_SOURCE_OPTIMAL;
+
+        case VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL:
+            return ImageLayout::TRANSFER_DESTINATION_OPTIMAL;
+
+        case VK_IMAGE_LAYOUT_GENERAL:
+            return ImageLayout::GENERAL;
+
+        case VK_IMAGE_LAYOUT_PRESENT_SRC_KHR:
+            return ImageLayout::PRESENT_SOURCE;
+
+        default:
+            return ImageLayout::UNDEFINED;
+    }
+}
+
+inline vulkanite::renderer::Image::UsageState vulkanite::renderer::Image::mapUsage(ImageUsage usage) {
+    switch (usage) {
+        case ImageUsage::TRANSFER_SOURCE:
+            return {VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_READ_BIT};
+
+        case ImageUsage::TRANSFER_DESTINATION:
+            return {VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT};
+
+        case ImageUsage::COLOUR_ATTACHMENT:
+            return {VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT};
+
+        case ImageUsage::DEPTH_STENCIL_ATTACHMENT:
+            return {VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL, VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT, VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT};
+
+        case ImageUsage::DEPTH_STENCIL_READ:
+            return {VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL, VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_SHADER_READ_BIT};
+
+        case ImageUsage::VERTEX_SHADER_READ:
+            return {VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_PIPELINE_STAGE_VERTEX_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT};
+
+        case ImageUsage::FRAGMENT_SHADER_READ:
+            return {VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT};
+
+        case ImageUsage::COMPUTE_SHADER_READ:
+            return {VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT};
+
+        case ImageUsage::COMPUTE_SHADER_WRITE:
+            return {VK_IMAGE_LAYOUT_GENERAL, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT};
+
+        case ImageUsage::PRESENT:
+            return {VK_IMAGE_LAYOUT_PRESENT_SRC_KHR, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, 0};
+
+        case ImageUsage::GENERAL:
+            return {VK_IMAGE_LAYOUT_GENERAL, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT};
+
+        default:
+            return {VK_IMAGE_LAYOUT_UNDEFINED, 0, 0};
+    }
+}
+
+inline VkImageAspectFlags vulkanite::renderer::Image::getAspectMask(VkFormat format) {
+    switch (format) {
+        case VK_FORMAT_D16_UNORM:
+        case VK_FORMAT_X8_D24_UNORM_PACK32:
+        case VK_FORMAT_D32_SFLOAT:
+            return VK_IMAGE_ASPECT_DEPTH_BIT;
+
+        case VK_FORMAT_S8_UINT:
+            return VK_IMAGE_ASPECT_STENCIL_BIT;
+
+        case VK_FORMAT_D16_UNORM_S8_UINT:
+        case VK_FORMAT_D24_UNORM_S8_UINT:
+        case VK_FORMAT_D32_SFLOAT_S8_UINT:
+            return VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT;
+
+        default:
+            return VK_IMAGE_ASPECT_COLOR_BIT;
+    }
 }
\ No newline at end of file
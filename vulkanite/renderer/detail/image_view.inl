@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../device.hpp"
+#include "../framebuffer.hpp"
 #include "../image.hpp"
 #include "../image_view.hpp"
 
@@ -28,18 +29,25 @@ inline void vulkanite::renderer::ImageView::create(const ImageViewCreateInfo& cr
     else {
         imageViewType_ = mapType(createInfo.type);
         image_ = createInfo.image.image_;
+        format_ = createInfo.image.format_;
         baseArrayLayer_ = createInfo.baseArrayLayer;
         baseMipLevel_ = createInfo.baseMipLevel;
         layerCount_ = createInfo.layerCount;
         levelCount_ = createInfo.levelCount;
         extent_ = createInfo.image.extent_;
-        device_ = createInfo.image.device_->device_;
+        device_ = createInfo.image.device_;
     }
 }
 
 inline void vulkanite::renderer::ImageView::destroy() {
     if (imageView_) {
-        vkDestroyImageView(device_, imageView_, nullptr);
+        std::lock_guard<std::mutex> lock(device_->framebufferCacheMutex_);
+
+        for (auto* cache : device_->framebufferCaches_) {
+            cache->evict(static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(imageView_)));
+        }
+
+        vkDestroyImageView(device_->device_, imageView_, nullptr);
 
         imageView_ = nullptr;
     }
@@ -60,6 +60,9 @@ inline void vulkanite::renderer::Instance::create(const InstanceCreateInfo& crea
     requestedExtensions.emplace_back(VK_KHR_PORTABILITY_ENUMERATION_EXTENSION_NAME);
 #endif
 
+    requestedExtensions.emplace_back(VK_KHR_GET_SURFACE_CAPABILITIES_2_EXTENSION_NAME);
+    requestedExtensions.emplace_back(VK_EXT_SURFACE_MAINTENANCE_1_EXTENSION_NAME);
+
     for (std::uint64_t i = 0; i < extensionProperties.size(); i++) {
         auto& available = extensionProperties[i];
 
@@ -77,6 +80,19 @@ inline void vulkanite::renderer::Instance::create(const InstanceCreateInfo& crea
         }
     }
 
+    std::uint32_t surfaceMaintenanceExtensionCount = 0;
+
+    for (auto* extension : selectedExtensions) {
+        bool isSurfaceCapabilities2 = std::string_view(extension) == VK_KHR_GET_SURFACE_CAPABILITIES_2_EXTENSION_NAME;
+        bool isSurfaceMaintenance1 = std::string_view(extension) == VK_EXT_SURFACE_MAINTENANCE_1_EXTENSION_NAME;
+
+        if (isSurfaceCapabilities2 || isSurfaceMaintenance1) {
+            surfaceMaintenanceExtensionCount++;
+        }
+    }
+
+    supportsSurfaceMaintenance_ = surfaceMaintenanceExtensionCount == 2;
+
     std::uint32_t availableLayerCount = 0;
 
     if (vkEnumerateInstanceLayerProperties(&availableLayerCount, nullptr) != VK_SUCCESS) {
@@ -169,6 +185,21 @@ inline void vulkanite::renderer::Instance::create(const InstanceCreateInfo& crea
 
     vkGetPhysicalDeviceMemoryProperties(physicalDevice_, &memoryProperties_);
     vkGetPhysicalDeviceProperties(physicalDevice_, &properties_);
+
+    // without resizable BAR the host-visible window into VRAM is limited to 256 MiB
+    constexpr VkDeviceSize barWindowSize = 256 * 1024 * 1024;
+    constexpr VkMemoryPropertyFlags barProperties = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT;
+
+    supportsLargeHostVisibleHeap_ = false;
+
+    for (std::uint32_t i = 0; i < memoryProperties_.memoryTypeCount; i++) {
+        auto& memoryType = memoryProperties_.memoryTypes[i];
+        auto& memoryHeap = memoryProperties_.memoryHeaps[memoryType.heapIndex];
+
+        if ((memoryType.propertyFlags & barProperties) == barProperties && memoryHeap.size > barWindowSize) {
+            supportsLargeHostVisibleHeap_ = true;
+        }
+    }
 }
 
 inline void vulkanite::renderer::Instance::destroy() {
@@ -0,0 +1,189 @@
+#pragma once
+
+#include "../device.hpp"
+#include "../layout_cache.hpp"
+#include "../pipeline.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+inline void vulkanite::renderer::LayoutCache::create(const LayoutCacheCreateInfo& createInfo) {
+    device_ = &createInfo.device;
+}
+
+inline void vulkanite::renderer::LayoutCache::destroy() {
+    std::lock_guard lock(mutex_);
+
+    for (auto& [key, pipelineLayout] : pipelineLayouts_) {
+        pipelineLayout.layout.destroy();
+    }
+
+    for (auto& [key, setLayout] : setLayouts_) {
+        setLayout.destroy();
+    }
+
+    pipelineLayouts_.clear();
+    setLayouts_.clear();
+}
+
+inline vulkanite::renderer::ReflectedPipelineLayout vulkanite::renderer::LayoutCache::getPipelineLayout(const std::vector<ShaderReflection>& reflections) {
+    std::map<std::pair<std::uint32_t, std::uint32_t>, ShaderResourceBinding> mergedBindings;
+
+    std::uint32_t pushConstantSizeBytes = 0;
+    Flags pushConstantStageFlags = DescriptorShaderStageFlags::NONE;
+
+    for (auto& reflection : reflections) {
+        for (auto& binding : reflection.bindings) {
+            auto [iterator, inserted] = mergedBindings.try_emplace({binding.set, binding.binding}, binding);
+
+            if (inserted) {
+                continue;
+            }
+
+            auto& merged = iterator->second;
+
+            if (merged.type != binding.type || merged.count != binding.count) {
+                throw std::runtime_error("Call failed: renderer::LayoutCache::getPipelineLayout(): Shaders disagree on the declaration at set " + std::to_string(binding.set) + " binding " + std::to_string(binding.binding));
+            }
+
+            merged.stageFlags |= binding.stageFlags;
+        }
+
+        if (reflection.pushConstantSizeBytes > 0) {
+            pushConstantSizeBytes = std::max(pushConstantSizeBytes, reflection.pushConstantSizeBytes);
+            pushConstantStageFlags |= ShaderReflector::mapStageFlags(reflection.stage);
+        }
+    }
+
+    std::vector<std::vector<DescriptorSetInputInfo>> sets;
+
+    for (auto& [location, binding] : mergedBindings) {
+        if (sets.size() <= binding.set) {
+            sets.resize(binding.set + 1);
+        }
+
+        sets[binding.set].push_back({
+            .type = binding.type,
+            .stageFlags = binding.stageFlags,
+            .count = binding.count,
+            .binding = binding.binding,
+        });
+    }
+
+    std::vector<std::uint64_t> key;
+
+    key.push_back(sets.size());
+
+    for (auto& inputs : sets) {
+        std::vector<std::uint64_t> setKey = serialise(inputs);
+
+        key.push_back(setKey.size());
+        key.insert(key.end(), setKey.begin(), setKey.end());
+    }
+
+    key.push_back(pushConstantSizeBytes);
+    key.push_back(pushConstantStageFlags);
+
+    std::lock_guard lock(mutex_);
+
+    auto iterator = pipelineLayouts_.find(key);
+
+    if (iterator != pipelineLayouts_.end()) {
+        return iterator->second;
+    }
+
+    ReflectedPipelineLayout reflectedLayout;
+
+    reflectedLayout.setLayouts.reserve(sets.size());
+
+    for (auto& inputs : sets) {
+        reflectedLayout.setLayouts.push_back(findDescriptorSetLayout(inputs));
+    }
+
+    if (pushConstantSizeBytes > 0) {
+        reflectedLayout.pushConstants.push_back({
+            .sizeBytes = pushConstantSizeBytes,
+            .stageFlags = pushConstantStageFlags,
+        });
+    }
+
+    reflectedLayout.layout.create({
+        .device = *device_,
+        .inputLayouts = reflectedLayout.setLayouts,
+        .pushConstants = reflectedLayout.pushConstants,
+    });
+
+    if (reflectedLayout.layout.pipelineLayout_ == nullptr) {
+        throw std::runtime_error("Call failed: renderer::LayoutCache::getPipelineLayout(): Failed to create pipeline layout");
+    }
+
+    pipelineLayouts_.emplace(std::move(key), reflectedLayout);
+
+    return reflectedLayout;
+}
+
+inline vulkanite::renderer::DescriptorSetLayout vulkanite::renderer::LayoutCache::getDescriptorSetLayout(const std::vector<DescriptorSetInputInfo>& inputs) {
+    std::lock_guard lock(mutex_);
+
+    return findDescriptorSetLayout(inputs);
+}
+
+inline std::uint32_t vulkanite::renderer::LayoutCache::getDescriptorSetLayoutCount() {
+    std::lock_guard lock(mutex_);
+
+    return static_cast<std::uint32_t>(setLayouts_.size());
+}
+
+inline std::uint32_t vulkanite::renderer::LayoutCache::getPipelineLayoutCount() {
+    std::lock_guard lock(mutex_);
+
+    return static_cast<std::uint32_t>(pipelineLayouts_.size());
+}
+
+inline vulkanite::renderer::DescriptorSetLayout vulkanite::renderer::LayoutCache::findDescriptorSetLayout(const std::vector<DescriptorSetInputInfo>& inputs) {
+    std::vector<std::uint64_t> key = serialise(inputs);
+
+    auto iterator = setLayouts_.find(key);
+
+    if (iterator != setLayouts_.end()) {
+        return iterator->second;
+    }
+
+    DescriptorSetLayout setLayout;
+
+    setLayout.create({
+        .device = *device_,
+        .inputs = inputs,
+    });
+
+    if (setLayout.descriptorSetLayout_ == nullptr) {
+        throw std::runtime_error("Call failed: renderer::LayoutCache::getDescriptorSetLayout(): Failed to create descriptor set layout");
+    }
+
+    setLayouts_.emplace(std::move(key), setLayout);
+
+    return setLayout;
+}
+
+inline std::vector<std::uint64_t> vulkanite::renderer::LayoutCache::serialise(const std::vector<DescriptorSetInputInfo>& inputs) {
+    std::vector<DescriptorSetInputInfo> sorted = inputs;
+
+    std::sort(sorted.begin(), sorted.end(), [](const DescriptorSetInputInfo& a, const DescriptorSetInputInfo& b) {
+        return a.binding < b.binding;
+    });
+
+    std::vector<std::uint64_t> key;
+
+    key.reserve(sorted.size() * 4);
+
+    for (auto& input : sorted) {
+        key.push_back(input.binding);
+        key.push_back(static_cast<std::uint64_t>(input.type));
+        key.push_back(input.count);
+        key.push_back(input.stageFlags);
+    }
+
+    return key;
+}
\ No newline at end of file
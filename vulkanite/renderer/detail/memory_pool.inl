@@ -0,0 +1,170 @@
+#pragma once
+
+#include "../device.hpp"
+#include "../memory_pool.hpp"
+
+#include <stdexcept>
+
+inline void vulkanite::renderer::MemoryPool::create(const MemoryPoolCreateInfo& createInfo) {
+    VmaMemoryUsage memoryUsage;
+    VkMemoryPropertyFlags memoryProperties;
+
+    switch (createInfo.memoryType) {
+        case MemoryType::DEVICE_LOCAL:
+            memoryUsage = VMA_MEMORY_USAGE_GPU_ONLY;
+            memoryProperties = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+            break;
+
+        case MemoryType::HOST_VISIBLE:
+            memoryUsage = VMA_MEMORY_USAGE_CPU_TO_GPU;
+            memoryProperties = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+            break;
+
+        case MemoryType::LAZILY_ALLOCATED:
+            memoryUsage = VMA_MEMORY_USAGE_GPU_LAZILY_ALLOCATED;
+            memoryProperties = VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT;
+            break;
+
+        case MemoryType::DEVICE_LOCAL_HOST_VISIBLE:
+            if (!createInfo.device.supportsDeviceLocalHostVisibleMemory()) {
+                throw std::runtime_error("Construction failed: renderer::MemoryPool: Device has no large host-visible device-local heap");
+            }
+
+            memoryUsage = VMA_MEMORY_USAGE_CPU_TO_GPU;
+            memoryProperties = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT;
+            break;
+
+        case MemoryType::HOST_CACHED:
+            memoryUsage = VMA_MEMORY_USAGE_GPU_TO_CPU;
+            memoryProperties = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_CACHED_BIT;
+            break;
+    }
+
+    if (createInfo.priority < 0.0f || createInfo.priority > 1.0f) {
+        throw std::runtime_error("Construction failed: renderer::MemoryPool: Priority must be between 0 and 1");
+    }
+
+    if (createInfo.memoryType == MemoryType::LAZILY_ALLOCATED && createInfo.resourceType == MemoryPoolResourceType::BUFFER) {
+        throw std::runtime_error("Construction failed: renderer::MemoryPool: Buffer pools cannot use lazily allocated memory");
+    }
+
+    VmaAllocationCreateInfo allocationCreateInfo = {
+        .flags = 0,
+        .usage = memoryUsage,
+        .requiredFlags = createInfo.memoryType == MemoryType::DEVICE_LOCAL_HOST_VISIBLE ? memoryProperties : 0,
+        .preferredFlags = memoryProperties,
+        .memoryTypeBits = 0,
+        .pool = nullptr,
+        .pUserData = nullptr,
+        .priority = 0.0,
+    };
+
+    std::uint32_t memoryTypeIndex = 0;
+    VkResult result = VK_SUCCESS;
+
+    if (createInfo.resourceType == MemoryPoolResourceType::BUFFER) {
+        VkBufferCreateInfo bufferCreateInfo = {
+            .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+            .pNext = nullptr,
+            .flags = 0,
+            .size = 1024,
+            .usage = BufferUsageFlags::mapFrom(createInfo.usageFlags),
+            .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+            .queueFamilyIndexCount = 0,
+            .pQueueFamilyIndices = nullptr,
+        };
+
+        result = vmaFindMemoryTypeIndexForBufferInfo(createInfo.device.allocator_, &bufferCreateInfo, &allocationCreateInfo, &memoryTypeIndex);
+    }
+    else {
+        VkImageCreateInfo imageCreateInfo = {
+            .sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+            .pNext = nullptr,
+            .flags = 0,
+            .imageType = VK_IMAGE_TYPE_2D,
+            .format = VK_FORMAT_R8G8B8A8_UNORM,
+            .extent = {1, 1, 1},
+            .mipLevels = 1,
+            .arrayLayers = 1,
+            .samples = VK_SAMPLE_COUNT_1_BIT,
+            .tiling = VK_IMAGE_TILING_OPTIMAL,
+            .usage = ImageUsageFlags::mapFrom(createInfo.usageFlags),
+            .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+            .queueFamilyIndexCount = 0,
+            .pQueueFamilyIndices = nullptr,
+            .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+        };
+
+        result = vmaFindMemoryTypeIndexForImageInfo(createInfo.device.allocator_, &imageCreateInfo, &allocationCreateInfo, &memoryTypeIndex);
+    }
+
+    if (result != VK_SUCCESS) {
+        pool_ = nullptr;
+
+        return;
+    }
+
+    VmaPoolCreateFlags poolFlags = 0;
+
+    if (createInfo.algorithm == MemoryPoolAlgorithm::LINEAR) {
+        poolFlags |= VMA_POOL_CREATE_LINEAR_ALGORITHM_BIT;
+    }
+
+    VmaPoolCreateInfo poolCreateInfo = {
+        .memoryTypeIndex = memoryTypeIndex,
+        .flags = poolFlags,
+        .blockSize = createInfo.blockSizeBytes,
+        .minBlockCount = createInfo.minBlockCount,
+        .maxBlockCount = createInfo.maxBlockCount,
+        .priority = createInfo.priority,
+        .minAllocationAlignment = 0,
+        .pMemoryAllocateNext = nullptr,
+    };
+
+    if (vmaCreatePool(createInfo.device.allocator_, &poolCreateInfo, &pool_) != VK_SUCCESS) {
+        pool_ = nullptr;
+    }
+    else {
+        device_ = &createInfo.device;
+        memoryType_ = createInfo.memoryType;
+        algorithm_ = createInfo.algorithm;
+    }
+}
+
+inline void vulkanite::renderer::MemoryPool::destroy() {
+    if (pool_) {
+        vmaDestroyPool(device_->allocator_, pool_);
+
+        pool_ = nullptr;
+    }
+}
+
+inline vulkanite::renderer::MemoryType vulkanite::renderer::MemoryPool::getMemoryType() const {
+    return memoryType_;
+}
+
+inline vulkanite::renderer::MemoryPoolAlgorithm vulkanite::renderer::MemoryPool::getAlgorithm() const {
+    return algorithm_;
+}
+
+inline std::uint32_t vulkanite::renderer::MemoryPool::getAllocationCount() const {
+    return getStatistics().allocationCount;
+}
+
+inline std::uint64_t vulkanite::renderer::MemoryPool::getAllocatedBytes() const {
+    return getStatistics().allocationBytes;
+}
+
+inline std::uint64_t vulkanite::renderer::MemoryPool::getReservedBytes() const {
+    return getStatistics().blockBytes;
+}
+
+inline VmaStatistics vulkanite::renderer::MemoryPool::getStatistics() const {
+    VmaStatistics statistics = {};
+
+    if (pool_) {
+        vmaGetPoolStatistics(device_->allocator_, pool_, &statistics);
+    }
+
+    return statistics;
+}
\ No newline at end of file
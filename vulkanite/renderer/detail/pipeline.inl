@@ -6,6 +6,9 @@
 #include "../pipeline.hpp"
 #include "../sampler.hpp"
 
+#include <chrono>
+#include <stdexcept>
+
 inline void vulkanite::renderer::DescriptorSetLayout::create(const DescriptorSetLayoutCreateInfo& createInfo) {
     std::vector<VkDescriptorSetLayoutBinding> bindings(createInfo.inputs.size());
 
@@ -13,15 +16,7 @@ inline void vulkanite::renderer::DescriptorSetLayout::create(const DescriptorSet
         auto& binding = bindings[i];
         auto& input = createInfo.inputs[i];
 
-        VkShaderStageFlags flags = 0;
-
-        if (input.stageFlags & DescriptorShaderStageFlags::VERTEX) {
-            flags |= VK_SHADER_STAGE_VERTEX_BIT;
-        }
-
-        if (input.stageFlags & DescriptorShaderStageFlags::FRAGMENT) {
-            flags |= VK_SHADER_STAGE_FRAGMENT_BIT;
-        }
+        VkShaderStageFlags flags = DescriptorShaderStageFlags::mapFrom(input.stageFlags);
 
         VkDescriptorType descriptorType = VK_DESCRIPTOR_TYPE_MAX_ENUM;
 
@@ -116,6 +111,8 @@ inline void vulkanite::renderer::DescriptorPool::create(const DescriptorPoolCrea
 }
 
 inline void vulkanite::renderer::DescriptorPool::destroy() {
+    std::lock_guard<std::mutex> lock(*mutex_);
+
     if (descriptorPool_) {
         vkDestroyDescriptorPool(device_->device_, descriptorPool_, nullptr);
 
@@ -139,10 +136,14 @@ inline std::vector<vulkanite::renderer::DescriptorSet> vulkanite::renderer::Desc
         .pSetLayouts = layouts.data(),
     };
 
+    std::unique_lock<std::mutex> lock(*mutex_);
+
     if (vkAllocateDescriptorSets(device_->device_, &allocationInfo, descriptorSets.data()) != VK_SUCCESS) {
         return {};
     }
 
+    lock.unlock();
+
     std::vector<DescriptorSet> sets;
 
     sets.reserve(createInfo.layouts.size());
@@ -189,6 +190,7 @@ inline void vulkanite::renderer::DescriptorPool::updateDescriptorSets(std::vecto
                 {ImageLayout::PREINITIALIZED, VK_IMAGE_LAYOUT_PREINITIALIZED},
                 {ImageLayout::COLOR_ATTACHMENT_OPTIMAL, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL},
                 {ImageLayout::DEPTH_STENCIL_ATTACHMENT_OPTIMAL, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL},
+                {ImageLayout::DEPTH_STENCIL_READ_ONLY_OPTIMAL, VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL},
                 {ImageLayout::SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL},
                 {ImageLayout::TRANSFER_SOURCE_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL},
                 {ImageLayout::TRANSFER_DESTINATION_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL},
@@ -259,15 +261,7 @@ inline void vulkanite::renderer::PipelineLayout::create(const PipelineLayoutCrea
         auto& info = pushConstants[i];
         auto& pushConstant = createInfo.pushConstants[i];
 
-        VkShaderStageFlags flags = 0;
-
-        if (pushConstant.stageFlags & DescriptorShaderStageFlags::VERTEX) {
-            flags |= VK_SHADER_STAGE_VERTEX_BIT;
-        }
-
-        if (pushConstant.stageFlags & DescriptorShaderStageFlags::FRAGMENT) {
-            flags |= VK_SHADER_STAGE_FRAGMENT_BIT;
-        }
+        VkShaderStageFlags flags = DescriptorShaderStageFlags::mapFrom(pushConstant.stageFlags);
 
         info = {
             .stageFlags = flags,
@@ -312,6 +306,89 @@ inline void vulkanite::renderer::Pipeline::destroy() {
     }
 }
 
+inline vulkanite::renderer::Flags vulkanite::renderer::Pipeline::getDynamicStateFlags() const {
+    return dynamicStateFlags_;
+}
+
+inline vulkanite::renderer::Flags vulkanite::renderer::Pipeline::getLibraryFlags() const {
+    return libraryFlags_;
+}
+
+inline void vulkanite::renderer::LinkedPipeline::create(const LinkedPipelineCreateInfo& createInfo) {
+    auto fastPipelines = createInfo.device.linkPipelines({
+        {
+            .layout = createInfo.layout,
+            .libraries = createInfo.libraries,
+            .optimise = false,
+        },
+    });
+
+    if (fastPipelines.empty()) {
+        throw std::runtime_error("Construction failed: renderer::LinkedPipeline: Failed to link pipeline libraries");
+    }
+
+    fastPipeline_ = fastPipelines.front();
+    optimised_ = false;
+
+    Device* device = &createInfo.device;
+    PipelineLayout layout = createInfo.layout;
+    std::vector<Pipeline> libraries = createInfo.libraries;
+
+    // the layout is copied so the background link does not depend on the caller's object outliving it
+    optimisation_ = std::async(std::launch::async, [device, layout, libraries]() mutable {
+        return device->linkPipelines({
+            {
+                .layout = layout,
+                .libraries = libraries,
+                .optimise = true,
+            },
+        });
+    });
+}
+
+inline void vulkanite::renderer::LinkedPipeline::destroy() {
+    if (optimisation_.valid()) {
+        try {
+            auto pipelines = optimisation_.get();
+
+            for (auto& pipeline : pipelines) {
+                pipeline.destroy();
+            }
+        }
+        catch (...) {
+        }
+    }
+
+    optimisedPipeline_.destroy();
+    fastPipeline_.destroy();
+
+    optimised_ = false;
+}
+
+inline vulkanite::renderer::Pipeline& vulkanite::renderer::LinkedPipeline::getPipeline() {
+    if (!optimised_ && optimisation_.valid() && optimisation_.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+        std::vector<Pipeline> pipelines;
+
+        // a failed background link must not surface mid-frame, the fast pipeline stays in use instead
+        try {
+            pipelines = optimisation_.get();
+        }
+        catch (...) {
+        }
+
+        if (!pipelines.empty()) {
+            optimisedPipeline_ = pipelines.front();
+            optimised_ = true;
+        }
+    }
+
+    return optimised_ ? optimisedPipeline_ : fastPipeline_;
+}
+
+inline bool vulkanite::renderer::LinkedPipeline::isOptimised() const {
+    return optimised_;
+}
+
 inline VkShaderStageFlagBits vulkanite::renderer::Pipeline::reverseMapShaderStage(ShaderStage stage) {
     switch (stage) {
         case ShaderStage::VERTEX:
@@ -320,6 +397,9 @@ inline VkShaderStageFlagBits vulkanite::renderer::Pipeline::reverseMapShaderStag
         case ShaderStage::FRAGMENT:
             return VK_SHADER_STAGE_FRAGMENT_BIT;
 
+        case ShaderStage::COMPUTE:
+            return VK_SHADER_STAGE_COMPUTE_BIT;
+
         default:
             return VK_SHADER_STAGE_FLAG_BITS_MAX_ENUM;
     }
@@ -0,0 +1,278 @@
+#pragma once
+
+#include "../device.hpp"
+#include "../pipeline.hpp"
+#include "../pipeline_registry.hpp"
+#include "../render_pass.hpp"
+#include "../shader_module.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+#include <type_traits>
+
+inline void vulkanite::renderer::PipelineRegistry::create(const PipelineRegistryCreateInfo& createInfo) {
+    capacity_ = std::bit_ceil(std::max(createInfo.capacity, 1u));
+    slots_ = std::make_unique<std::atomic<Entry*>[]>(capacity_);
+    pipelineCount_ = 0;
+    device_ = &createInfo.device;
+}
+
+inline void vulkanite::renderer::PipelineRegistry::destroy() {
+    if (!slots_) {
+        return;
+    }
+
+    for (std::uint32_t i = 0; i < capacity_; i++) {
+        Entry* entry = slots_[i].exchange(nullptr);
+
+        if (entry == nullptr) {
+            continue;
+        }
+
+        entry->pipeline.destroy();
+
+        delete entry;
+    }
+
+    slots_.reset();
+    capacity_ = 0;
+    pipelineCount_ = 0;
+}
+
+inline const vulkanite::renderer::Pipeline& vulkanite::renderer::PipelineRegistry::getPipeline(const PipelineCreateInfo& createInfo) {
+    std::vector<std::uint64_t> key = serialise(createInfo);
+    std::uint64_t keyHash = hash(key);
+    std::uint64_t mask = capacity_ - 1;
+
+    Entry* created = nullptr;
+
+    for (std::uint64_t probe = 0; probe < capacity_; probe++) {
+        auto& slot = slots_[(keyHash + probe) & mask];
+
+        Entry* entry = slot.load(std::memory_order_acquire);
+
+        if (entry == nullptr) {
+            if (created == nullptr) {
+                created = new Entry();
+                created->hash = keyHash;
+                created->key = std::move(key);
+            }
+
+            if (slot.compare_exchange_strong(entry, created, std::memory_order_acq_rel, std::memory_order_acquire)) {
+                return buildEntry(*created, createInfo);
+            }
+        }
+
+        const auto& probeKey = created != nullptr ? created->key : key;
+
+        if (entry->hash != keyHash || entry->key != probeKey) {
+            continue;
+        }
+
+        delete created;
+
+        EntryState state = entry->state.load(std::memory_order_acquire);
+
+        // a failed entry stays in its slot to keep probe chains intact, the first caller to claim it retries
+        if (state == EntryState::FAILED && entry->state.compare_exchange_strong(state, EntryState::PENDING, std::memory_order_acq_rel, std::memory_order_acquire)) {
+            return buildEntry(*entry, createInfo);
+        }
+
+        while (state == EntryState::PENDING) {
+            entry->state.wait(state, std::memory_order_acquire);
+
+            state = entry->state.load(std::memory_order_acquire);
+        }
+
+        if (state == EntryState::FAILED) {
+            return failedPipeline_;
+        }
+
+        return entry->pipeline;
+    }
+
+    delete created;
+
+    throw std::runtime_error("Call failed: renderer::PipelineRegistry::getPipeline(): Registry capacity exhausted");
+}
+
+inline const vulkanite::renderer::Pipeline& vulkanite::renderer::PipelineRegistry::buildEntry(Entry& entry, const PipelineCreateInfo& createInfo) {
+    std::vector<Pipeline> pipelines;
+
+    try {
+        pipelines = device_->createPipelines({createInfo});
+    }
+    catch (...) {
+        entry.state.store(EntryState::FAILED, std::memory_order_release);
+        entry.state.notify_all();
+
+        throw;
+    }
+
+    if (pipelines.empty()) {
+        entry.state.store(EntryState::FAILED, std::memory_order_release);
+        entry.state.notify_all();
+
+        return failedPipeline_;
+    }
+
+    entry.pipeline = pipelines.front();
+
+    pipelineCount_.fetch_add(1, std::memory_order_relaxed);
+
+    entry.state.store(EntryState::READY, std::memory_order_release);
+    entry.state.notify_all();
+
+    return entry.pipeline;
+}
+
+inline std::uint32_t vulkanite::renderer::PipelineRegistry::getPipelineCount() const {
+    return pipelineCount_.load(std::memory_order_relaxed);
+}
+
+inline std::vector<std::uint64_t> vulkanite::renderer::PipelineRegistry::serialise(const PipelineCreateInfo& createInfo) {
+    std::vector<std::uint64_t> key;
+
+    auto pushValue = [&](auto value) {
+        using Type = decltype(value);
+
+        if constexpr (std::is_pointer_v<Type>) {
+            key.push_back(static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(value)));
+        }
+        else if constexpr (std::is_enum_v<Type>) {
+            key.push_back(static_cast<std::uint64_t>(value));
+        }
+        else if constexpr (std::is_same_v<Type, float>) {
+            key.push_back(std::bit_cast<std::uint32_t>(value));
+        }
+        else {
+            key.push_back(static_cast<std::uint64_t>(value));
+        }
+    };
+
+    auto pushBytes = [&](const auto* data, std::uint64_t size) {
+        const auto* bytes = reinterpret_cast<const std::uint8_t*>(data);
+
+        pushValue(size);
+
+        for (std::uint64_t i = 0; i < size; i += sizeof(std::uint64_t)) {
+            std::uint64_t word = 0;
+
+            for (std::uint64_t j = i; j < std::min(i + sizeof(std::uint64_t), size); j++) {
+                word |= static_cast<std::uint64_t>(bytes[j]) << ((j - i) * 8);
+            }
+
+            key.push_back(word);
+        }
+    };
+
+    auto pushFace = [&](const PerFaceRasterisationState& face) {
+        pushValue(face.depthComparison);
+        pushValue(face.stencilComparison);
+        pushValue(face.stencilFailOperation);
+        pushValue(face.depthFailOperation);
+        pushValue(face.passOperation);
+        pushValue(face.stencilCompareMask);
+        pushValue(face.stencilWriteMask);
+    };
+
+    pushValue(createInfo.shaderStages.size());
+
+    for (auto& stage : createInfo.shaderStages) {
+        pushValue(stage.module.module_);
+        pushValue(stage.stage);
+        pushBytes(stage.entryPoint.data(), stage.entryPoint.size());
+        pushValue(stage.specialisationConstants.size());
+
+        for (auto& constant : stage.specialisationConstants) {
+            pushValue(constant.constantID);
+            pushValue(constant.offsetBytes);
+            pushValue(constant.sizeBytes);
+        }
+
+        pushBytes(stage.specialisationData.data(), stage.specialisationData.size());
+    }
+
+    pushValue(createInfo.vertexInput.bindings.size());
+
+    for (auto& binding : createInfo.vertexInput.bindings) {
+        pushValue(binding.inputRate);
+        pushValue(binding.binding);
+        pushValue(binding.strideBytes);
+    }
+
+    pushValue(createInfo.vertexInput.attributes.size());
+
+    for (auto& attribute : createInfo.vertexInput.attributes) {
+        pushValue(attribute.format);
+        pushValue(attribute.binding);
+        pushValue(attribute.location);
+    }
+
+    pushValue(createInfo.inputAssembly.topology);
+    pushValue(createInfo.inputAssembly.primitiveRestart);
+
+    pushValue(createInfo.viewportCount);
+    pushValue(createInfo.scissorCount);
+
+    pushValue(createInfo.rasterisation.frontFaceWinding);
+    pushValue(createInfo.rasterisation.cullMode);
+    pushFace(createInfo.rasterisation.frontface);
+    pushFace(createInfo.rasterisation.backface);
+    pushValue(createInfo.rasterisation.depthClampEnable);
+    pushValue(createInfo.rasterisation.depthTestEnable);
+    pushValue(createInfo.rasterisation.depthWriteEnable);
+    pushValue(createInfo.rasterisation.depthBoundsTestEnable);
+    pushValue(createInfo.rasterisation.stencilTestEnable);
+
+    pushValue(createInfo.multisample.sampleCount);
+    pushValue(createInfo.multisample.sampleShadingEnable);
+    pushValue(createInfo.multisample.alphaToCoverageEnable);
+    pushValue(createInfo.multisample.alphaToOneEnable);
+    pushValue(createInfo.multisample.minSampleShading);
+
+    pushValue(createInfo.colourBlend.attachments.size());
+
+    for (auto& attachment : createInfo.colourBlend.attachments) {
+        pushValue(attachment.blendEnable);
+        pushValue(attachment.colourWriteMask);
+        pushValue(attachment.sourceColourBlendFactor);
+        pushValue(attachment.destinationColourBlendFactor);
+        pushValue(attachment.colourBlendOperation);
+        pushValue(attachment.sourceAlphaBlendFactor);
+        pushValue(attachment.destinationAlphaBlendFactor);
+        pushValue(attachment.alphaBlendOperation);
+    }
+
+    VkRenderPass renderPass = createInfo.renderPass ? createInfo.renderPass->renderPass_ : nullptr;
+
+    pushValue(createInfo.layout.pipelineLayout_);
+    pushValue(renderPass);
+    pushValue(createInfo.rendering.colourFormats.size());
+
+    for (auto& format : createInfo.rendering.colourFormats) {
+        pushValue(format);
+    }
+
+    pushValue(createInfo.rendering.depthStencilFormat.has_value());
+    pushValue(createInfo.rendering.depthStencilFormat.value_or(ImageFormat{}));
+    pushValue(createInfo.subpassIndex);
+    pushValue(createInfo.dynamicStateFlags);
+    pushValue(createInfo.libraryFlags);
+
+    return key;
+}
+
+inline std::uint64_t vulkanite::renderer::PipelineRegistry::hash(const std::vector<std::uint64_t>& key) {
+    std::uint64_t value = 0xCBF29CE484222325ull;
+
+    for (std::uint64_t word : key) {
+        for (std::uint64_t i = 0; i < sizeof(std::uint64_t); i++) {
+            value ^= (word >> (i * 8)) & 0xFF;
+            value *= 0x100000001B3ull;
+        }
+    }
+
+    return value;
+}
\ No newline at end of file
@@ -38,5 +38,7 @@ inline bool vulkanite::renderer::Queue::submit(const QueueSubmitInfo& submitInfo
         .pSignalSemaphores = signals.data(),
     };
 
+    std::lock_guard<std::mutex> lock(*mutex_);
+
     return vkQueueSubmit(queue_, static_cast<std::uint32_t>(buffers.size()), &vkSubmitInfo, (submitInfo.fence.fence_ != nullptr) ? submitInfo.fence.fence_ : nullptr) == VK_SUCCESS;
 }
\ No newline at end of file
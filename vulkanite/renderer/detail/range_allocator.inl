@@ -0,0 +1,137 @@
+#pragma once
+
+#include "../range_allocator.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+
+inline void vulkanite::renderer::RangeAllocator::create(std::uint32_t capacity) {
+    freeRanges_.clear();
+
+    if (capacity > 0) {
+        freeRanges_.emplace(0, capacity);
+    }
+
+    capacity_ = capacity;
+    usedCount_ = 0;
+}
+
+inline void vulkanite::renderer::RangeAllocator::destroy() {
+    freeRanges_.clear();
+
+    capacity_ = 0;
+    usedCount_ = 0;
+}
+
+inline std::optional<std::uint32_t> vulkanite::renderer::RangeAllocator::allocate(std::uint32_t count) {
+    if (count == 0) {
+        return std::nullopt;
+    }
+
+    auto best = freeRanges_.end();
+
+    for (auto it = freeRanges_.begin(); it != freeRanges_.end(); it++) {
+        if (it->second >= count && (best == freeRanges_.end() || it->second < best->second)) {
+            best = it;
+
+            if (it->second == count) {
+                break;
+            }
+        }
+    }
+
+    if (best == freeRanges_.end()) {
+        return std::nullopt;
+    }
+
+    std::uint32_t first = best->first;
+    std::uint32_t remaining = best->second - count;
+
+    freeRanges_.erase(best);
+
+    if (remaining > 0) {
+        freeRanges_.emplace(first + count, remaining);
+    }
+
+    usedCount_ += count;
+
+    return first;
+}
+
+inline void vulkanite::renderer::RangeAllocator::free(std::uint32_t first, std::uint32_t count) {
+    if (count == 0) {
+        return;
+    }
+
+    if (!isAllocated(first, count)) {
+        throw std::runtime_error("Call failed: renderer::RangeAllocator::free(): Range is outside the capacity or already free");
+    }
+
+    usedCount_ -= count;
+
+    auto next = freeRanges_.lower_bound(first);
+
+    if (next != freeRanges_.end() && first + count == next->first) {
+        count += next->second;
+        next = freeRanges_.erase(next);
+    }
+
+    if (next != freeRanges_.begin()) {
+        auto previous = std::prev(next);
+
+        if (previous->first + previous->second == first) {
+            previous->second += count;
+
+            return;
+        }
+    }
+
+    freeRanges_.emplace_hint(next, first, count);
+}
+
+inline bool vulkanite::renderer::RangeAllocator::isAllocated(std::uint32_t first, std::uint32_t count) const {
+    std::uint64_t end = static_cast<std::uint64_t>(first) + count;
+
+    if (count == 0 || end > capacity_) {
+        return false;
+    }
+
+    auto next = freeRanges_.lower_bound(first);
+
+    if (next != freeRanges_.end() && next->first < end) {
+        return false;
+    }
+
+    if (next != freeRanges_.begin()) {
+        auto previous = std::prev(next);
+
+        if (static_cast<std::uint64_t>(previous->first) + previous->second > first) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+inline std::uint32_t vulkanite::renderer::RangeAllocator::getCapacity() const {
+    return capacity_;
+}
+
+inline std::uint32_t vulkanite::renderer::RangeAllocator::getUsedCount() const {
+    return usedCount_;
+}
+
+inline std::uint32_t vulkanite::renderer::RangeAllocator::getLargestFreeRange() const {
+    std::uint32_t largest = 0;
+
+    for (auto& [first, count] : freeRanges_) {
+        largest = std::max(largest, count);
+    }
+
+    return largest;
+}
+
+inline std::uint32_t vulkanite::renderer::RangeAllocator::getFreeRangeCount() const {
+    return static_cast<std::uint32_t>(freeRanges_.size());
+}
\ No newline at end of file
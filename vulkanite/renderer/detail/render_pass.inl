@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../device.hpp"
+#include "../framebuffer.hpp"
 #include "../image.hpp"
 #include "../render_pass.hpp"
 
@@ -23,6 +24,7 @@ inline void vulkanite::renderer::RenderPass::create(const RenderPassCreateInfo&
             {ImageLayout::PREINITIALIZED, VK_IMAGE_LAYOUT_PREINITIALIZED},
             {ImageLayout::COLOR_ATTACHMENT_OPTIMAL, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL},
             {ImageLayout::DEPTH_STENCIL_ATTACHMENT_OPTIMAL, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL},
+            {ImageLayout::DEPTH_STENCIL_READ_ONLY_OPTIMAL, VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL},
             {ImageLayout::SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL},
             {ImageLayout::TRANSFER_SOURCE_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL},
             {ImageLayout::TRANSFER_DESTINATION_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL},
@@ -67,6 +69,7 @@ inline void vulkanite::renderer::RenderPass::create(const RenderPassCreateInfo&
             {ImageLayout::PREINITIALIZED, VK_IMAGE_LAYOUT_PREINITIALIZED},
             {ImageLayout::COLOR_ATTACHMENT_OPTIMAL, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL},
             {ImageLayout::DEPTH_STENCIL_ATTACHMENT_OPTIMAL, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL},
+            {ImageLayout::DEPTH_STENCIL_READ_ONLY_OPTIMAL, VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL},
             {ImageLayout::SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL},
             {ImageLayout::TRANSFER_SOURCE_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL},
             {ImageLayout::TRANSFER_DESTINATION_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL},
@@ -182,6 +185,12 @@ inline void vulkanite::renderer::RenderPass::create(const RenderPassCreateInfo&
 
 inline void vulkanite::renderer::RenderPass::destroy() {
     if (renderPass_) {
+        std::lock_guard<std::mutex> lock(device_->framebufferCacheMutex_);
+
+        for (auto* cache : device_->framebufferCaches_) {
+            cache->evict(static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(renderPass_)));
+        }
+
         vkDestroyRenderPass(device_->device_, renderPass_, nullptr);
     }
 
@@ -4,6 +4,10 @@
 #include "../shader_module.hpp"
 
 inline void vulkanite::renderer::ShaderModule::create(const ShaderModuleCreateInfo& createInfo) {
+    if (createInfo.reflect) {
+        reflection_ = ShaderReflection::reflect(createInfo.data, createInfo.entryPoint);
+    }
+
     VkShaderModuleCreateInfo shaderModuleCreateInfo = {
         .sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO,
         .pNext = nullptr,
@@ -24,4 +28,8 @@ inline void vulkanite::renderer::ShaderModule::destroy() {
     if (module_) {
         vkDestroyShaderModule(device_->device_, module_, nullptr);
     }
+}
+
+inline const vulkanite::renderer::ShaderReflection& vulkanite::renderer::ShaderModule::getReflection() const {
+    return reflection_;
 }
\ No newline at end of file
@@ -0,0 +1,588 @@
+#pragma once
+
+#include "../shader_reflection.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+namespace vulkanite::renderer::spirv {
+    constexpr std::uint32_t MAGIC_NUMBER = 0x07230203;
+    constexpr std::uint32_t HEADER_WORD_COUNT = 5;
+
+    constexpr std::uint32_t OP_ENTRY_POINT = 15;
+    constexpr std::uint32_t OP_EXECUTION_MODE = 16;
+    constexpr std::uint32_t OP_TYPE_BOOL = 20;
+    constexpr std::uint32_t OP_TYPE_INT = 21;
+    constexpr std::uint32_t OP_TYPE_FLOAT = 22;
+    constexpr std::uint32_t OP_TYPE_VECTOR = 23;
+    constexpr std::uint32_t OP_TYPE_MATRIX = 24;
+    constexpr std::uint32_t OP_TYPE_IMAGE = 25;
+    constexpr std::uint32_t OP_TYPE_SAMPLER = 26;
+    constexpr std::uint32_t OP_TYPE_SAMPLED_IMAGE = 27;
+    constexpr std::uint32_t OP_TYPE_ARRAY = 28;
+    constexpr std::uint32_t OP_TYPE_RUNTIME_ARRAY = 29;
+    constexpr std::uint32_t OP_TYPE_STRUCT = 30;
+    constexpr std::uint32_t OP_TYPE_POINTER = 32;
+    constexpr std::uint32_t OP_CONSTANT = 43;
+    constexpr std::uint32_t OP_SPEC_CONSTANT = 50;
+    constexpr std::uint32_t OP_VARIABLE = 59;
+    constexpr std::uint32_t OP_DECORATE = 71;
+    constexpr std::uint32_t OP_MEMBER_DECORATE = 72;
+    constexpr std::uint32_t OP_EXECUTION_MODE_ID = 331;
+
+    constexpr std::uint32_t DECORATION_BLOCK = 2;
+    constexpr std::uint32_t DECORATION_BUFFER_BLOCK = 3;
+    constexpr std::uint32_t DECORATION_ARRAY_STRIDE = 6;
+    constexpr std::uint32_t DECORATION_MATRIX_STRIDE = 7;
+    constexpr std::uint32_t DECORATION_BUILT_IN = 11;
+    constexpr std::uint32_t DECORATION_LOCATION = 30;
+    constexpr std::uint32_t DECORATION_BINDING = 33;
+    constexpr std::uint32_t DECORATION_DESCRIPTOR_SET = 34;
+    constexpr std::uint32_t DECORATION_OFFSET = 35;
+
+    constexpr std::uint32_t STORAGE_CLASS_UNIFORM_CONSTANT = 0;
+    constexpr std::uint32_t STORAGE_CLASS_INPUT = 1;
+    constexpr std::uint32_t STORAGE_CLASS_UNIFORM = 2;
+    constexpr std::uint32_t STORAGE_CLASS_PUSH_CONSTANT = 9;
+    constexpr std::uint32_t STORAGE_CLASS_STORAGE_BUFFER = 12;
+
+    constexpr std::uint32_t EXECUTION_MODEL_VERTEX = 0;
+    constexpr std::uint32_t EXECUTION_MODEL_FRAGMENT = 4;
+    constexpr std::uint32_t EXECUTION_MODEL_GL_COMPUTE = 5;
+
+    constexpr std::uint32_t EXECUTION_MODE_LOCAL_SIZE = 17;
+    constexpr std::uint32_t EXECUTION_MODE_LOCAL_SIZE_ID = 38;
+
+    constexpr std::uint32_t getMinimumOperandCount(std::uint32_t opcode) {
+        switch (opcode) {
+            case OP_ENTRY_POINT:
+            case OP_TYPE_INT:
+            case OP_TYPE_VECTOR:
+            case OP_TYPE_MATRIX:
+            case OP_TYPE_ARRAY:
+            case OP_TYPE_POINTER:
+            case OP_CONSTANT:
+            case OP_SPEC_CONSTANT:
+            case OP_VARIABLE:
+            case OP_MEMBER_DECORATE:
+                return 3;
+
+            case OP_EXECUTION_MODE:
+            case OP_EXECUTION_MODE_ID:
+            case OP_DECORATE:
+            case OP_TYPE_FLOAT:
+            case OP_TYPE_SAMPLED_IMAGE:
+            case OP_TYPE_RUNTIME_ARRAY:
+                return 2;
+
+            case OP_TYPE_BOOL:
+            case OP_TYPE_IMAGE:
+            case OP_TYPE_SAMPLER:
+            case OP_TYPE_STRUCT:
+                return 1;
+
+            default:
+                return 0;
+        }
+    }
+}
+
+inline vulkanite::renderer::ShaderReflection vulkanite::renderer::ShaderReflection::reflect(std::span<const std::uint32_t> code, std::string_view entryPoint) {
+    ShaderReflection reflection = {};
+    ShaderReflector reflector;
+
+    reflector.parse(code, entryPoint, reflection);
+    reflector.reflectVariables(reflection);
+
+    return reflection;
+}
+
+inline void vulkanite::renderer::ShaderReflector::parse(std::span<const std::uint32_t> code, std::string_view entryPoint, ShaderReflection& reflection) {
+    if (code.size() < spirv::HEADER_WORD_COUNT || code[0] != spirv::MAGIC_NUMBER) {
+        throw std::runtime_error("Call failed: renderer::ShaderReflection::reflect(): Data is not a SPIR-V module");
+    }
+
+    struct EntryPoint {
+        std::uint32_t executionModel;
+        std::uint32_t id;
+
+        std::string name;
+        std::vector<std::uint32_t> interface;
+    };
+
+    std::vector<EntryPoint> entryPoints;
+    std::unordered_map<std::uint32_t, glm::uvec3> workgroupSizes;
+    std::unordered_map<std::uint32_t, glm::uvec3> workgroupSizeIDs;
+
+    std::uint64_t offset = spirv::HEADER_WORD_COUNT;
+
+    while (offset < code.size()) {
+        std::uint32_t wordCount = code[offset] >> 16;
+        std::uint32_t opcode = code[offset] & 0xFFFF;
+
+        if (wordCount == 0 || offset + wordCount > code.size() || wordCount - 1 < spirv::getMinimumOperandCount(opcode)) {
+            throw std::runtime_error("Call failed: renderer::ShaderReflection::reflect(): Malformed SPIR-V instruction");
+        }
+
+        auto operands = code.subspan(offset + 1, wordCount - 1);
+
+        offset += wordCount;
+
+        auto requireOperands = [&](std::uint64_t count) {
+            if (operands.size() < count) {
+                throw std::runtime_error("Call failed: renderer::ShaderReflection::reflect(): Malformed SPIR-V instruction");
+            }
+        };
+
+        switch (opcode) {
+            case spirv::OP_ENTRY_POINT: {
+                const char* name = reinterpret_cast<const char*>(operands.data() + 2);
+
+                std::uint64_t nameCapacity = (operands.size() - 2) * sizeof(std::uint32_t);
+                std::uint64_t nameLength = strnlen(name, nameCapacity);
+
+                if (nameLength == nameCapacity) {
+                    throw std::runtime_error("Call failed: renderer::ShaderReflection::reflect(): Malformed SPIR-V instruction");
+                }
+
+                auto interface = operands.subspan(2 + nameLength / sizeof(std::uint32_t) + 1);
+
+                entryPoints.push_back({
+                    .executionModel = operands[0],
+                    .id = operands[1],
+                    .name = std::string(name, nameLength),
+                    .interface = std::vector<std::uint32_t>(interface.begin(), interface.end()),
+                });
+
+                break;
+            }
+
+            case spirv::OP_EXECUTION_MODE:
+                if (operands[1] == spirv::EXECUTION_MODE_LOCAL_SIZE) {
+                    requireOperands(5);
+
+                    workgroupSizes[operands[0]] = {operands[2], operands[3], operands[4]};
+                }
+
+                break;
+
+            case spirv::OP_EXECUTION_MODE_ID:
+                if (operands[1] == spirv::EXECUTION_MODE_LOCAL_SIZE_ID) {
+                    requireOperands(5);
+
+                    workgroupSizeIDs[operands[0]] = {operands[2], operands[3], operands[4]};
+                }
+
+                break;
+
+            case spirv::OP_DECORATE: {
+                auto& decorations = decorations_[operands[0]];
+
+                switch (operands[1]) {
+                    case spirv::DECORATION_BLOCK:
+                        decorations.block = true;
+                        break;
+
+                    case spirv::DECORATION_BUFFER_BLOCK:
+                        decorations.bufferBlock = true;
+                        break;
+
+                    case spirv::DECORATION_ARRAY_STRIDE:
+                        requireOperands(3);
+                        decorations.arrayStride = operands[2];
+                        break;
+
+                    case spirv::DECORATION_BUILT_IN:
+                        decorations.builtIn = true;
+                        break;
+
+                    case spirv::DECORATION_LOCATION:
+                        requireOperands(3);
+                        decorations.location = operands[2];
+                        decorations.hasLocation = true;
+                        break;
+
+                    case spirv::DECORATION_BINDING:
+                        requireOperands(3);
+                        decorations.binding = operands[2];
+                        decorations.hasBinding = true;
+                        break;
+
+                    case spirv::DECORATION_DESCRIPTOR_SET:
+                        requireOperands(3);
+                        decorations.set = operands[2];
+                        break;
+                }
+
+                break;
+            }
+
+            case spirv::OP_MEMBER_DECORATE: {
+                auto& members = memberDecorations_[operands[0]];
+
+                if (members.size() <= operands[1]) {
+                    members.resize(operands[1] + 1);
+                }
+
+                auto& member = members[operands[1]];
+
+                switch (operands[2]) {
+                    case spirv::DECORATION_OFFSET:
+                        requireOperands(4);
+                        member.offset = operands[3];
+                        break;
+
+                    case spirv::DECORATION_MATRIX_STRIDE:
+                        requireOperands(4);
+                        member.matrixStride = operands[3];
+                        break;
+                }
+
+                break;
+            }
+
+            case spirv::OP_TYPE_BOOL:
+            case spirv::OP_TYPE_INT:
+            case spirv::OP_TYPE_FLOAT:
+            case spirv::OP_TYPE_VECTOR:
+            case spirv::OP_TYPE_MATRIX:
+            case spirv::OP_TYPE_IMAGE:
+            case spirv::OP_TYPE_SAMPLER:
+            case spirv::OP_TYPE_SAMPLED_IMAGE:
+            case spirv::OP_TYPE_ARRAY:
+            case spirv::OP_TYPE_RUNTIME_ARRAY:
+            case spirv::OP_TYPE_STRUCT:
+            case spirv::OP_TYPE_POINTER:
+                types_[operands[0]] = {
+                    .opcode = opcode,
+                    .operands = std::vector<std::uint32_t>(operands.begin() + 1, operands.end()),
+                };
+
+                break;
+
+            case spirv::OP_CONSTANT:
+            case spirv::OP_SPEC_CONSTANT:
+                constants_[operands[1]] = operands[2];
+                break;
+
+            case spirv::OP_VARIABLE:
+                variables_.push_back({
+                    .id = operands[1],
+                    .pointerType = operands[0],
+                    .storageClass = operands[2],
+                });
+
+                break;
+        }
+    }
+
+    if (entryPoints.empty()) {
+        throw std::runtime_error("Call failed: renderer::ShaderReflection::reflect(): Module has no entry point");
+    }
+
+    const EntryPoint* selected = nullptr;
+
+    if (entryPoint.empty()) {
+        if (entryPoints.size() > 1) {
+            throw std::runtime_error("Call failed: renderer::ShaderReflection::reflect(): Module has several entry points, one must be named");
+        }
+
+        selected = &entryPoints.front();
+    }
+    else {
+        for (auto& candidate : entryPoints) {
+            if (candidate.name == entryPoint) {
+                selected = &candidate;
+                break;
+            }
+        }
+
+        if (!selected) {
+            throw std::runtime_error("Call failed: renderer::ShaderReflection::reflect(): Module has no entry point named " + std::string(entryPoint));
+        }
+    }
+
+    switch (selected->executionModel) {
+        case spirv::EXECUTION_MODEL_VERTEX:
+            reflection.stage = ShaderStage::VERTEX;
+            break;
+
+        case spirv::EXECUTION_MODEL_FRAGMENT:
+            reflection.stage = ShaderStage::FRAGMENT;
+            break;
+
+        case spirv::EXECUTION_MODEL_GL_COMPUTE:
+            reflection.stage = ShaderStage::COMPUTE;
+            break;
+
+        default:
+            throw std::runtime_error("Call failed: renderer::ShaderReflection::reflect(): Unsupported shader execution model");
+    }
+
+    reflection.entryPoint = selected->name;
+    interface_ = selected->interface;
+
+    if (auto sizeIDs = workgroupSizeIDs.find(selected->id); sizeIDs != workgroupSizeIDs.end()) {
+        reflection.workgroupSize = {getConstant(sizeIDs->second.x), getConstant(sizeIDs->second.y), getConstant(sizeIDs->second.z)};
+    }
+    else if (auto size = workgroupSizes.find(selected->id); size != workgroupSizes.end()) {
+        reflection.workgroupSize = size->second;
+    }
+}
+
+inline void vulkanite::renderer::ShaderReflector::reflectVariables(ShaderReflection& reflection) {
+    for (auto& variable : variables_) {
+        auto& pointerType = getType(variable.pointerType);
+
+        if (pointerType.opcode != spirv::OP_TYPE_POINTER) {
+            throw std::runtime_error("Call failed: renderer::ShaderReflection::reflect(): Variable " + std::to_string(variable.id) + " does not have a pointer type");
+        }
+
+        std::uint32_t typeID = pointerType.operands[1];
+
+        auto& decorations = getDecorations(variable.id);
+
+        switch (variable.storageClass) {
+            case spirv::STORAGE_CLASS_INPUT: {
+                bool usedByEntryPoint = std::find(interface_.begin(), interface_.end(), variable.id) != interface_.end();
+
+                if (reflection.stage != ShaderStage::VERTEX || !usedByEntryPoint || decorations.builtIn || !decorations.hasLocation) {
+                    break;
+                }
+
+                auto& type = getType(typeID);
+
+                if (type.opcode == spirv::OP_TYPE_VECTOR) {
+                    reflection.vertexInputs.push_back({
+                        .format = mapVertexAttributeFormat(getType(type.operands[0]), type.operands[1]),
+                        .location = decorations.location,
+                    });
+                }
+                else {
+                    reflection.vertexInputs.push_back({
+                        .format = mapVertexAttributeFormat(type, 1),
+                        .location = decorations.location,
+                    });
+                }
+
+                break;
+            }
+
+            case spirv::STORAGE_CLASS_PUSH_CONSTANT:
+                reflection.pushConstantSizeBytes = std::max(reflection.pushConstantSizeBytes, static_cast<std::uint32_t>(getTypeSize(typeID)));
+                break;
+
+            case spirv::STORAGE_CLASS_UNIFORM_CONSTANT:
+            case spirv::STORAGE_CLASS_UNIFORM:
+            case spirv::STORAGE_CLASS_STORAGE_BUFFER: {
+                if (!decorations.hasBinding) {
+                    break;
+                }
+
+                std::uint32_t count = getElementCount(typeID);
+
+                auto& type = getType(typeID);
+                auto& typeDecorations = getDecorations(typeID);
+
+                DescriptorInputType inputType;
+
+                if (variable.storageClass == spirv::STORAGE_CLASS_STORAGE_BUFFER || (variable.storageClass == spirv::STORAGE_CLASS_UNIFORM && typeDecorations.bufferBlock)) {
+                    inputType = DescriptorInputType::STORAGE_BUFFER;
+                }
+                else if (variable.storageClass == spirv::STORAGE_CLASS_UNIFORM) {
+                    inputType = DescriptorInputType::UNIFORM_BUFFER;
+                }
+                else if (type.opcode == spirv::OP_TYPE_SAMPLED_IMAGE) {
+                    inputType = DescriptorInputType::IMAGE_SAMPLER;
+                }
+                else {
+                    throw std::runtime_error("Call failed: renderer::ShaderReflection::reflect(): Unsupported descriptor type at set " + std::to_string(decorations.set) + " binding " + std::to_string(decorations.binding));
+                }
+
+                reflection.bindings.push_back({
+                    .type = inputType,
+                    .stageFlags = mapStageFlags(reflection.stage),
+                    .set = decorations.set,
+                    .binding = decorations.binding,
+                    .count = count,
+                });
+
+                break;
+            }
+        }
+    }
+
+    std::sort(reflection.bindings.begin(), reflection.bindings.end(), [](const ShaderResourceBinding& a, const ShaderResourceBinding& b) {
+        return a.set != b.set ? a.set < b.set : a.binding < b.binding;
+    });
+
+    std::sort(reflection.vertexInputs.begin(), reflection.vertexInputs.end(), [](const ShaderVertexInput& a, const ShaderVertexInput& b) {
+        return a.location < b.location;
+    });
+}
+
+inline std::uint64_t vulkanite::renderer::ShaderReflector::getTypeSize(std::uint32_t typeID) {
+    auto& type = getType(typeID);
+
+    switch (type.opcode) {
+        case spirv::OP_TYPE_BOOL:
+            return sizeof(std::uint32_t);
+
+        case spirv::OP_TYPE_INT:
+        case spirv::OP_TYPE_FLOAT:
+            return type.operands[0] / 8;
+
+        case spirv::OP_TYPE_VECTOR:
+        case spirv::OP_TYPE_MATRIX:
+            return getTypeSize(type.operands[0]) * type.operands[1];
+
+        case spirv::OP_TYPE_ARRAY: {
+            std::uint64_t stride = getDecorations(typeID).arrayStride;
+
+            if (stride == 0) {
+                stride = getTypeSize(type.operands[0]);
+            }
+
+            return stride * getConstant(type.operands[1]);
+        }
+
+        case spirv::OP_TYPE_STRUCT: {
+            std::uint64_t size = 0;
+
+            auto& members = getMemberDecorations(typeID);
+
+            for (std::uint64_t i = 0; i < type.operands.size(); i++) {
+                std::uint64_t offset = i < members.size() ? members[i].offset : size;
+
+                size = std::max(size, offset + getMemberSize(typeID, static_cast<std::uint32_t>(i)));
+            }
+
+            return size;
+        }
+
+        default:
+            return 0;
+    }
+}
+
+inline std::uint64_t vulkanite::renderer::ShaderReflector::getMemberSize(std::uint32_t structID, std::uint32_t member) {
+    std::uint32_t memberTypeID = getType(structID).operands[member];
+
+    auto& memberType = getType(memberTypeID);
+    auto& members = getMemberDecorations(structID);
+
+    if (memberType.opcode == spirv::OP_TYPE_MATRIX && member < members.size() && members[member].matrixStride != 0) {
+        return static_cast<std::uint64_t>(members[member].matrixStride) * memberType.operands[1];
+    }
+
+    return getTypeSize(memberTypeID);
+}
+
+inline std::uint32_t vulkanite::renderer::ShaderReflector::getElementCount(std::uint32_t& typeID) {
+    std::uint32_t count = 1;
+
+    while (true) {
+        auto& type = getType(typeID);
+
+        if (type.opcode == spirv::OP_TYPE_ARRAY) {
+            count *= getConstant(type.operands[1]);
+            typeID = type.operands[0];
+        }
+        else if (type.opcode == spirv::OP_TYPE_RUNTIME_ARRAY) {
+            throw std::runtime_error("Call failed: renderer::ShaderReflection::reflect(): Runtime descriptor arrays are not supported");
+        }
+        else {
+            return count;
+        }
+    }
+}
+
+inline const vulkanite::renderer::ShaderReflector::Type& vulkanite::renderer::ShaderReflector::getType(std::uint32_t typeID) const {
+    auto type = types_.find(typeID);
+
+    if (type == types_.end()) {
+        throw std::runtime_error("Call failed: renderer::ShaderReflection::reflect(): Unknown type ID " + std::to_string(typeID));
+    }
+
+    return type->second;
+}
+
+inline std::uint32_t vulkanite::renderer::ShaderReflector::getConstant(std::uint32_t constantID) const {
+    auto constant = constants_.find(constantID);
+
+    if (constant == constants_.end()) {
+        throw std::runtime_error("Call failed: renderer::ShaderReflection::reflect(): Unknown constant ID " + std::to_string(constantID));
+    }
+
+    return constant->second;
+}
+
+inline const vulkanite::renderer::ShaderReflector::Decorations& vulkanite::renderer::ShaderReflector::getDecorations(std::uint32_t id) const {
+    static const Decorations undecorated = {};
+
+    auto decorations = decorations_.find(id);
+
+    return decorations != decorations_.end() ? decorations->second : undecorated;
+}
+
+inline const std::vector<vulkanite::renderer::ShaderReflector::MemberDecorations>& vulkanite::renderer::ShaderReflector::getMemberDecorations(std::uint32_t structID) const {
+    static const std::vector<MemberDecorations> undecorated;
+
+    auto members = memberDecorations_.find(structID);
+
+    return members != memberDecorations_.end() ? members->second : undecorated;
+}
+
+inline vulkanite::renderer::Flags vulkanite::renderer::ShaderReflector::mapStageFlags(ShaderStage stage) {
+    switch (stage) {
+        case ShaderStage::VERTEX:
+            return DescriptorShaderStageFlags::VERTEX;
+
+        case ShaderStage::FRAGMENT:
+            return DescriptorShaderStageFlags::FRAGMENT;
+
+        case ShaderStage::COMPUTE:
+            return DescriptorShaderStageFlags::COMPUTE;
+
+        default:
+            return DescriptorShaderStageFlags::NONE;
+    }
+}
+
+inline vulkanite::renderer::VertexAttributeFormat vulkanite::renderer::ShaderReflector::mapVertexAttributeFormat(const Type& scalar, std::uint32_t componentCount) {
+    constexpr VertexAttributeFormat floatFormats[] = {
+        VertexAttributeFormat::R32_FLOAT,
+        VertexAttributeFormat::R32G32_FLOAT,
+        VertexAttributeFormat::R32G32B32_FLOAT,
+        VertexAttributeFormat::R32G32B32A32_FLOAT,
+    };
+
+    constexpr VertexAttributeFormat intFormats[] = {
+        VertexAttributeFormat::R32_INT,
+        VertexAttributeFormat::R32G32_INT,
+        VertexAttributeFormat::R32G32B32_INT,
+        VertexAttributeFormat::R32G32B32A32_INT,
+    };
+
+    constexpr VertexAttributeFormat uintFormats[] = {
+        VertexAttributeFormat::R32_UINT,
+        VertexAttributeFormat::R32G32_UINT,
+        VertexAttributeFormat::R32G32B32_UINT,
+        VertexAttributeFormat::R32G32B32A32_UINT,
+    };
+
+    bool isScalar = scalar.opcode == spirv::OP_TYPE_FLOAT || scalar.opcode == spirv::OP_TYPE_INT;
+
+    if (!isScalar || scalar.operands[0] != 32 || componentCount == 0 || componentCount > 4) {
+        throw std::runtime_error("Call failed: renderer::ShaderReflection::reflect(): Unsupported vertex input type");
+    }
+
+    if (scalar.opcode == spirv::OP_TYPE_FLOAT) {
+        return floatFormats[componentCount - 1];
+    }
+
+    return scalar.operands[1] ? intFormats[componentCount - 1] : uintFormats[componentCount - 1];
+}
\ No newline at end of file
@@ -13,6 +13,12 @@
 
 inline vulkanite::renderer::SwapchainResult vulkanite::renderer::Swapchain::create(const SwapchainCreateInfo& createInfo) {
     VkSwapchainKHR oldSwapchain = nullptr;
+    VkSwapchainKHR oldHandle = nullptr;
+
+    if (createInfo.oldSwapchain) {
+        oldHandle = createInfo.oldSwapchain->swapchain_;
+        oldSwapchain = createInfo.oldSwapchain->retired_ ? nullptr : oldHandle;
+    }
 
     synchronise_ = createInfo.shouldSynchronise;
     instance_ = createInfo.device.instance_;
@@ -20,6 +26,18 @@ inline vulkanite::renderer::SwapchainResult vulkanite::renderer::Swapchain::crea
     surface_ = &createInfo.surface;
     presentQueue_ = &createInfo.presentQueue;
     recreate_ = false;
+    latencyMode_ = createInfo.latencyMode;
+    maxFramesInFlight_ = std::max(createInfo.maxFramesInFlight, 1u);
+
+    if (createInfo.presentModePolicy) {
+        presentModePolicy_ = createInfo.presentModePolicy;
+    }
+    else if (createInfo.oldSwapchain) {
+        presentModePolicy_ = createInfo.oldSwapchain->presentModePolicy_;
+    }
+    else {
+        presentModePolicy_.reset();
+    }
 
     VkSurfaceCapabilitiesKHR surfaceCapabilities = getSurfaceCapabilities();
 
@@ -29,6 +47,7 @@ inline vulkanite::renderer::SwapchainResult vulkanite::renderer::Swapchain::crea
 
     selectSurfaceFormat();
     selectPresentMode();
+    queryCompatiblePresentModes();
 
     std::uint32_t imageCountMaximum = std::min(createInfo.requestedImageCount, surfaceCapabilities.maxImageCount);
     imageCount_ = std::max(imageCountMaximum, surfaceCapabilities.minImageCount);
@@ -40,9 +59,16 @@ inline vulkanite::renderer::SwapchainResult vulkanite::renderer::Swapchain::crea
     extent_.width = std::clamp(extent_.width, surfaceCapabilities.minImageExtent.width, surfaceCapabilities.maxImageExtent.width);
     extent_.height = std::clamp(extent_.height, surfaceCapabilities.minImageExtent.height, surfaceCapabilities.maxImageExtent.height);
 
+    VkSwapchainPresentModesCreateInfoEXT presentModesCreateInfo = {
+        .sType = VK_STRUCTURE_TYPE_SWAPCHAIN_PRESENT_MODES_CREATE_INFO_EXT,
+        .pNext = nullptr,
+        .presentModeCount = static_cast<std::uint32_t>(compatiblePresentModes_.size()),
+        .pPresentModes = compatiblePresentModes_.data(),
+    };
+
     VkSwapchainCreateInfoKHR swapchainCreateInfo = {
         .sType = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR,
-        .pNext = nullptr,
+        .pNext = compatiblePresentModes_.empty() ? nullptr : &presentModesCreateInfo,
         .flags = 0,
         .surface = createInfo.surface.surface_,
         .minImageCount = imageCount_,
@@ -61,16 +87,23 @@ inline vulkanite::renderer::SwapchainResult vulkanite::renderer::Swapchain::crea
         .oldSwapchain = oldSwapchain,
     };
 
-    VkResult error = vkCreateSwapchainKHR(createInfo.device.device_, &swapchainCreateInfo, nullptr, &swapchain_);
+    VkSwapchainKHR swapchain = nullptr;
+    VkResult error = vkCreateSwapchainKHR(createInfo.device.device_, &swapchainCreateInfo, nullptr, &swapchain);
 
-    if (error == VK_ERROR_NATIVE_WINDOW_IN_USE_KHR) {
-        if (createInfo.oldSwapchain) {
-            createInfo.oldSwapchain->~Swapchain();
-        }
+    if (createInfo.oldSwapchain && oldSwapchain) {
+        createInfo.oldSwapchain->retired_ = true;
+    }
 
+    if (error == VK_ERROR_NATIVE_WINDOW_IN_USE_KHR && createInfo.oldSwapchain) {
+        device_->waitIdle();
+
+        createInfo.oldSwapchain->destroy();
+
+        oldSwapchain = nullptr;
+        oldHandle = nullptr;
         swapchainCreateInfo.oldSwapchain = nullptr;
 
-        error = vkCreateSwapchainKHR(createInfo.device.device_, &swapchainCreateInfo, nullptr, &swapchain_);
+        error = vkCreateSwapchainKHR(createInfo.device.device_, &swapchainCreateInfo, nullptr, &swapchain);
     }
 
     if (error == VK_ERROR_NATIVE_WINDOW_IN_USE_KHR) {
@@ -84,10 +117,17 @@ inline vulkanite::renderer::SwapchainResult vulkanite::renderer::Swapchain::crea
     }
     else {
         if (createInfo.oldSwapchain) {
-            createInfo.oldSwapchain->~Swapchain();
+            retire(*createInfo.oldSwapchain, oldHandle);
         }
 
+        swapchain_ = swapchain;
+        retired_ = false;
+        presentId_ = 0;
+
+        inputSamples_.clear();
+
         createImageResources();
+        createPacingResources();
 
         return SwapchainResult::SUCCESS;
     }
@@ -110,6 +150,9 @@ inline void vulkanite::renderer::Swapchain::destroy() {
 
         swapchain_ = nullptr;
     }
+
+    releaseRetiredSwapchains(true);
+    releasePacingResources();
 }
 
 inline bool vulkanite::renderer::Swapchain::acquireNextImage(Semaphore& acquireSemaphore) {
@@ -117,7 +160,26 @@ inline bool vulkanite::renderer::Swapchain::acquireNextImage(Semaphore& acquireS
         return false;
     }
 
-    VkResult result = vkAcquireNextImageKHR(device_->device_, swapchain_, UINT32_MAX, acquireSemaphore.semaphore_, nullptr, &imageIndex_);
+    waitForFrameSlot();
+
+    VkFence acquireFence = nullptr;
+    std::uint64_t slot = 0;
+
+    if (!acquireFences_.empty()) {
+        slot = frameIndex_ % acquireFences_.size();
+        acquireFence = acquireFences_[slot];
+    }
+
+    VkResult result = vkAcquireNextImageKHR(device_->device_, swapchain_, UINT32_MAX, acquireSemaphore.semaphore_, acquireFence, &imageIndex_);
+
+    if (acquireFence && (result == VK_SUCCESS || result == VK_SUBOPTIMAL_KHR)) {
+        acquireFencesPending_[slot] = true;
+        frameIndex_++;
+
+        if (latencyMode_ == LatencyMode::LOW_LATENCY) {
+            vkWaitForFences(device_->device_, 1, &acquireFence, VK_TRUE, std::numeric_limits<std::uint64_t>::max());
+        }
+    }
 
     if (result == VK_ERROR_OUT_OF_DATE_KHR) {
         recreate_ = true;
@@ -132,9 +194,33 @@ inline bool vulkanite::renderer::Swapchain::acquireNextImage(Semaphore& acquireS
 inline bool vulkanite::renderer::Swapchain::presentNextImage(Semaphore& presentSemaphore) {
     auto& queue = presentQueue_->queue_;
 
+    bool tracksPresents = device_->enabledFeatures_ & DeviceFeatureFlags::PRESENT_WAIT;
+
+    std::uint64_t presentId = presentId_ + 1;
+
+    VkPresentIdKHR presentIdInfo = {
+        .sType = VK_STRUCTURE_TYPE_PRESENT_ID_KHR,
+        .pNext = nullptr,
+        .swapchainCount = 1,
+        .pPresentIds = &presentId,
+    };
+
+    const void* presentNext = tracksPresents ? &presentIdInfo : nullptr;
+
+    VkSwapchainPresentModeInfoEXT presentModeInfo = {
+        .sType = VK_STRUCTURE_TYPE_SWAPCHAIN_PRESENT_MODE_INFO_EXT,
+        .pNext = presentNext,
+        .swapchainCount = 1,
+        .pPresentModes = &presentMode_,
+    };
+
+    if (!compatiblePresentModes_.empty()) {
+        presentNext = &presentModeInfo;
+    }
+
     VkPresentInfoKHR presentInfo = {
         .sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR,
-        .pNext = nullptr,
+        .pNext = presentNext,
         .waitSemaphoreCount = 1,
         .pWaitSemaphores = &presentSemaphore.semaphore_,
         .swapchainCount = 1,
@@ -143,8 +229,31 @@ inline bool vulkanite::renderer::Swapchain::presentNextImage(Semaphore& presentS
         .pResults = nullptr,
     };
 
+    std::unique_lock<std::mutex> queueLock(*presentQueue_->mutex_);
+
     VkResult result = vkQueuePresentKHR(queue, &presentInfo);
 
+    queueLock.unlock();
+
+    if (result == VK_SUCCESS || result == VK_SUBOPTIMAL_KHR) {
+        presentId_ = presentId;
+
+        if (pendingInputSample_ && tracksPresents) {
+            inputSamples_.push_back({
+                .presentId = presentId,
+                .time = pendingInputSample_.value(),
+            });
+        }
+        else if (pendingInputSample_) {
+            // without present wait the display time is unknown, so this only covers input to submission
+            inputLatency_ = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - pendingInputSample_.value());
+        }
+
+        pendingInputSample_.reset();
+    }
+
+    releaseRetiredSwapchains(false);
+
     if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR) {
         recreate_ = true;
     }
@@ -187,6 +296,68 @@ inline glm::uvec2 vulkanite::renderer::Swapchain::getExtent() const {
     return {extent_.width, extent_.height};
 }
 
+inline vulkanite::renderer::LatencyMode vulkanite::renderer::Swapchain::getLatencyMode() const {
+    return latencyMode_;
+}
+
+inline std::uint32_t vulkanite::renderer::Swapchain::getMaxFramesInFlight() const {
+    return maxFramesInFlight_;
+}
+
+inline std::chrono::nanoseconds vulkanite::renderer::Swapchain::getInputLatency() const {
+    return inputLatency_;
+}
+
+inline vulkanite::renderer::PresentMode vulkanite::renderer::Swapchain::getPresentMode() const {
+    return reverseMapPresentMode(presentMode_);
+}
+
+inline std::vector<vulkanite::renderer::PresentMode> vulkanite::renderer::Swapchain::getSupportedPresentModes() const {
+    std::vector<PresentMode> presentModes;
+
+    for (auto mode : supportedPresentModes_) {
+        bool isKnown = mode == VK_PRESENT_MODE_IMMEDIATE_KHR || mode == VK_PRESENT_MODE_MAILBOX_KHR || mode == VK_PRESENT_MODE_FIFO_KHR || mode == VK_PRESENT_MODE_FIFO_RELAXED_KHR;
+
+        if (isKnown) {
+            presentModes.push_back(reverseMapPresentMode(mode));
+        }
+    }
+
+    return presentModes;
+}
+
+inline std::optional<vulkanite::renderer::PresentModePolicy> vulkanite::renderer::Swapchain::getPresentModePolicy() const {
+    return presentModePolicy_;
+}
+
+inline void vulkanite::renderer::Swapchain::setLatencyMode(LatencyMode mode) {
+    latencyMode_ = mode;
+}
+
+inline bool vulkanite::renderer::Swapchain::setPresentModePolicy(PresentModePolicy policy) {
+    presentModePolicy_ = policy;
+
+    VkPresentModeKHR mode = choosePresentMode(policy);
+
+    if (mode == presentMode_) {
+        return true;
+    }
+
+    if (std::find(compatiblePresentModes_.begin(), compatiblePresentModes_.end(), mode) != compatiblePresentModes_.end()) {
+        presentMode_ = mode;
+
+        return true;
+    }
+
+    recreate_ = true;
+
+    return false;
+}
+
+inline void vulkanite::renderer::Swapchain::markInputSample() {
+    pendingInputSample_ = std::chrono::steady_clock::now();
+}
+
 inline void vulkanite::renderer::Swapchain::createImageResources() {
     auto& device = device_->device_;
 
@@ -223,6 +394,8 @@ inline void vulkanite::renderer::Swapchain::createImageResources() {
         image.sampleCount_ = 1;
         image.device_ = device_;
 
+        image.initialiseSubresourceStates(VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT);
+
         ImageViewCreateInfo viewCreateInfo = {
             .image = image,
             .type = ImageViewType::IMAGE_2D,
@@ -239,6 +412,202 @@ inline void vulkanite::renderer::Swapchain::createImageResources() {
     }
 }
 
+inline void vulkanite::renderer::Swapchain::retire(Swapchain& oldSwapchain, VkSwapchainKHR oldHandle) {
+    if (&oldSwapchain != this) {
+        for (auto& retired : oldSwapchain.retiredSwapchains_) {
+            retiredSwapchains_.push_back(std::move(retired));
+        }
+
+        oldSwapchain.retiredSwapchains_.clear();
+        oldSwapchain.swapchain_ = nullptr;
+    }
+
+    if (oldHandle) {
+        RetiredSwapchain retired = {
+            .swapchain = oldHandle,
+            .imageViews = std::move(oldSwapchain.imageViews_),
+            .fences = {},
+        };
+
+        VkFenceCreateInfo fenceCreateInfo = {
+            .sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO,
+            .pNext = nullptr,
+            .flags = 0,
+        };
+
+        std::vector<VkQueue> markedQueues;
+        bool marked = true;
+
+        // an empty submission on every queue signals once all work that could still use the old images has completed
+        for (auto& queue : device_->queues_) {
+            if (std::find(markedQueues.begin(), markedQueues.end(), queue.queue_) != markedQueues.end()) {
+                continue;
+            }
+
+            VkFence fence = nullptr;
+
+            if (vkCreateFence(device_->device_, &fenceCreateInfo, nullptr, &fence) != VK_SUCCESS) {
+                marked = false;
+
+                break;
+            }
+
+            retired.fences.push_back(fence);
+            markedQueues.push_back(queue.queue_);
+
+            std::lock_guard<std::mutex> lock(*queue.mutex_);
+
+            if (vkQueueSubmit(queue.queue_, 0, nullptr, fence) != VK_SUCCESS) {
+                marked = false;
+
+                break;
+            }
+        }
+
+        if (!marked) {
+            device_->waitIdle();
+
+            for (auto& fence : retired.fences) {
+                vkDestroyFence(device_->device_, fence, nullptr);
+            }
+
+            retired.fences.clear();
+        }
+
+        retiredSwapchains_.push_back(std::move(retired));
+    }
+
+    oldSwapchain.images_.clear();
+    oldSwapchain.imageViews_.clear();
+}
+
+inline void vulkanite::renderer::Swapchain::releaseRetiredSwapchains(bool force) {
+    for (auto iterator = retiredSwapchains_.begin(); iterator != retiredSwapchains_.end();) {
+        auto& retired = *iterator;
+
+        bool complete = std::all_of(retired.fences.begin(), retired.fences.end(), [&](VkFence fence) {
+            return vkGetFenceStatus(device_->device_, fence) == VK_SUCCESS;
+        });
+
+        if (!force && !complete) {
+            iterator++;
+
+            continue;
+        }
+
+        if (!complete) {
+            vkWaitForFences(device_->device_, static_cast<std::uint32_t>(retired.fences.size()), retired.fences.data(), VK_TRUE, std::numeric_limits<std::uint64_t>::max());
+        }
+
+        for (auto& fence : retired.fences) {
+            vkDestroyFence(device_->device_, fence, nullptr);
+        }
+
+        for (auto& view : retired.imageViews) {
+            view.destroy();
+        }
+
+        vkDestroySwapchainKHR(device_->device_, retired.swapchain, nullptr);
+
+        iterator = retiredSwapchains_.erase(iterator);
+    }
+}
+
+inline void vulkanite::renderer::Swapchain::createPacingResources() {
+    if (device_->enabledFeatures_ & DeviceFeatureFlags::PRESENT_WAIT) {
+        releasePacingResources();
+
+        return;
+    }
+
+    if (acquireFences_.size() == maxFramesInFlight_) {
+        return;
+    }
+
+    releasePacingResources();
+
+    VkFenceCreateInfo fenceCreateInfo = {
+        .sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO,
+        .pNext = nullptr,
+        .flags = 0,
+    };
+
+    acquireFences_.resize(maxFramesInFlight_, nullptr);
+    acquireFencesPending_.assign(maxFramesInFlight_, false);
+
+    for (auto& fence : acquireFences_) {
+        if (vkCreateFence(device_->device_, &fenceCreateInfo, nullptr, &fence) != VK_SUCCESS) {
+            throw std::runtime_error("Construction failed: renderer::Swapchain: Failed to create frame pacing fences");
+        }
+    }
+}
+
+inline void vulkanite::renderer::Swapchain::releasePacingResources() {
+    for (std::uint64_t i = 0; i < acquireFences_.size(); i++) {
+        if (!acquireFences_[i]) {
+            continue;
+        }
+
+        if (acquireFencesPending_[i]) {
+            vkWaitForFences(device_->device_, 1, &acquireFences_[i], VK_TRUE, std::numeric_limits<std::uint64_t>::max());
+        }
+
+        vkDestroyFence(device_->device_, acquireFences_[i], nullptr);
+    }
+
+    acquireFences_.clear();
+    acquireFencesPending_.clear();
+    frameIndex_ = 0;
+}
+
+inline void vulkanite::renderer::Swapchain::waitForFrameSlot() {
+    if (device_->enabledFeatures_ & DeviceFeatureFlags::PRESENT_WAIT) {
+        constexpr std::uint64_t presentWaitTimeout = 1'000'000'000;
+
+        std::uint64_t allowedPresents = latencyMode_ == LatencyMode::LOW_LATENCY ? 0 : maxFramesInFlight_ - 1;
+
+        if (presentId_ <= allowedPresents) {
+            return;
+        }
+
+        std::uint64_t targetId = presentId_ - allowedPresents;
+
+        VkResult result = device_->functions_.waitForPresent(device_->device_, swapchain_, targetId, presentWaitTimeout);
+
+        if (result == VK_ERROR_OUT_OF_DATE_KHR) {
+            recreate_ = true;
+        }
+        else if (result == VK_SUCCESS || result == VK_SUBOPTIMAL_KHR) {
+            recordInputLatency(targetId);
+        }
+
+        return;
+    }
+
+    // without present wait, pacing blocks on the acquire fence of the frame that last used this slot
+    if (acquireFences_.empty()) {
+        return;
+    }
+
+    std::uint64_t slot = frameIndex_ % acquireFences_.size();
+
+    if (acquireFencesPending_[slot]) {
+        vkWaitForFences(device_->device_, 1, &acquireFences_[slot], VK_TRUE, std::numeric_limits<std::uint64_t>::max());
+        vkResetFences(device_->device_, 1, &acquireFences_[slot]);
+
+        acquireFencesPending_[slot] = false;
+    }
+}
+
+inline void vulkanite::renderer::Swapchain::recordInputLatency(std::uint64_t presentedId) {
+    auto now = std::chrono::steady_clock::now();
+
+    while (!inputSamples_.empty() && inputSamples_.front().presentId <= presentedId) {
+        inputLatency_ = std::chrono::duration_cast<std::chrono::nanoseconds>(now - inputSamples_.front().time);
+        inputSamples_.pop_front();
+    }
+}
+
 inline VkSurfaceCapabilitiesKHR vulkanite::renderer::Swapchain::getSurfaceCapabilities() {
     auto& physicalDevice = instance_->physicalDevice_;
     auto& surface = surface_->surface_;
@@ -305,6 +674,8 @@ inline void vulkanite::renderer::Swapchain::selectPresentMode() {
     auto& physicalDevice = instance_->physicalDevice_;
     auto& surface = surface_->surface_;
 
+    supportedPresentModes_.clear();
+
     std::uint32_t presentModeCount = 0;
 
     if (vkGetPhysicalDeviceSurfacePresentModesKHR(physicalDevice, surface, &presentModeCount, nullptr) != VK_SUCCESS) {
@@ -321,6 +692,14 @@ inline void vulkanite::renderer::Swapchain::selectPresentMode() {
         return;
     }
 
+    supportedPresentModes_ = presentModes;
+
+    if (presentModePolicy_) {
+        presentMode_ = choosePresentMode(presentModePolicy_.value());
+
+        return;
+    }
+
     presentMode_ = VK_PRESENT_MODE_FIFO_KHR;
 
     std::int32_t chosenPriority = -1;
@@ -346,4 +725,108 @@ inline void vulkanite::renderer::Swapchain::selectPresentMode() {
             presentMode_ = mode;
         }
     }
+}
+
+inline void vulkanite::renderer::Swapchain::queryCompatiblePresentModes() {
+    compatiblePresentModes_.clear();
+
+    if (!(device_->enabledFeatures_ & DeviceFeatureFlags::SWAPCHAIN_MAINTENANCE_1) || presentMode_ == VK_PRESENT_MODE_MAX_ENUM_KHR) {
+        return;
+    }
+
+    auto getSurfaceCapabilities2 = reinterpret_cast<PFN_vkGetPhysicalDeviceSurfaceCapabilities2KHR>(vkGetInstanceProcAddr(instance_->instance_, "vkGetPhysicalDeviceSurfaceCapabilities2KHR"));
+
+    if (!getSurfaceCapabilities2) {
+        return;
+    }
+
+    VkSurfacePresentModeEXT surfacePresentMode = {
+        .sType = VK_STRUCTURE_TYPE_SURFACE_PRESENT_MODE_EXT,
+        .pNext = nullptr,
+        .presentMode = presentMode_,
+    };
+
+    VkPhysicalDeviceSurfaceInfo2KHR surfaceInfo = {
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SURFACE_INFO_2_KHR,
+        .pNext = &surfacePresentMode,
+        .surface = surface_->surface_,
+    };
+
+    VkSurfacePresentModeCompatibilityEXT compatibility = {
+        .sType = VK_STRUCTURE_TYPE_SURFACE_PRESENT_MODE_COMPATIBILITY_EXT,
+        .pNext = nullptr,
+        .presentModeCount = 0,
+        .pPresentModes = nullptr,
+    };
+
+    VkSurfaceCapabilities2KHR capabilities = {
+        .sType = VK_STRUCTURE_TYPE_SURFACE_CAPABILITIES_2_KHR,
+        .pNext = &compatibility,
+        .surfaceCapabilities = {},
+    };
+
+    if (getSurfaceCapabilities2(instance_->physicalDevice_, &surfaceInfo, &capabilities) != VK_SUCCESS) {
+        return;
+    }
+
+    compatiblePresentModes_.resize(compatibility.presentModeCount);
+    compatibility.pPresentModes = compatiblePresentModes_.data();
+
+    if (getSurfaceCapabilities2(instance_->physicalDevice_, &surfaceInfo, &capabilities) != VK_SUCCESS) {
+        compatiblePresentModes_.clear();
+
+        return;
+    }
+
+    compatiblePresentModes_.resize(compatibility.presentModeCount);
+
+    if (std::find(compatiblePresentModes_.begin(), compatiblePresentModes_.end(), presentMode_) == compatiblePresentModes_.end()) {
+        compatiblePresentModes_.push_back(presentMode_);
+    }
+}
+
+inline VkPresentModeKHR vulkanite::renderer::Swapchain::choosePresentMode(PresentModePolicy policy) const {
+    std::vector<VkPresentModeKHR> preferences;
+
+    switch (policy) {
+        case PresentModePolicy::VSYNC:
+            preferences = {VK_PRESENT_MODE_FIFO_KHR};
+            break;
+
+        case PresentModePolicy::ADAPTIVE:
+            preferences = {VK_PRESENT_MODE_FIFO_RELAXED_KHR, VK_PRESENT_MODE_FIFO_KHR};
+            break;
+
+        case PresentModePolicy::UNCAPPED:
+            preferences = {VK_PRESENT_MODE_IMMEDIATE_KHR, VK_PRESENT_MODE_MAILBOX_KHR, VK_PRESENT_MODE_FIFO_KHR};
+            break;
+
+        case PresentModePolicy::LOWEST_LATENCY:
+            preferences = {VK_PRESENT_MODE_MAILBOX_KHR, VK_PRESENT_MODE_IMMEDIATE_KHR, VK_PRESENT_MODE_FIFO_RELAXED_KHR, VK_PRESENT_MODE_FIFO_KHR};
+            break;
+    }
+
+    for (auto preference : preferences) {
+        if (std::find(supportedPresentModes_.begin(), supportedPresentModes_.end(), preference) != supportedPresentModes_.end()) {
+            return preference;
+        }
+    }
+
+    return VK_PRESENT_MODE_FIFO_KHR;
+}
+
+inline vulkanite::renderer::PresentMode vulkanite::renderer::Swapchain::reverseMapPresentMode(VkPresentModeKHR mode) {
+    switch (mode) {
+        case VK_PRESENT_MODE_IMMEDIATE_KHR:
+            return PresentMode::IMMEDIATE;
+
+        case VK_PRESENT_MODE_MAILBOX_KHR:
+            return PresentMode::MAILBOX;
+
+        case VK_PRESENT_MODE_FIFO_RELAXED_KHR:
+            return PresentMode::FIFO_RELAXED;
+
+        default:
+            return PresentMode::FIFO;
+    }
 }
\ No newline at end of file
@@ -4,8 +4,20 @@
 
 #if VULKANITE_SUPPORTED
 
+#include "configuration.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
 #include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <span>
+#include <thread>
+#include <utility>
+#include <vector>
 
 #include <vk_mem_alloc.h>
 #include <vulkan/vulkan.h>
@@ -16,16 +28,57 @@ namespace vulkanite::renderer {
     class Pipeline;
     class Queue;
     class Fence;
+    class Semaphore;
+    class FramebufferCache;
+    class CommandPool;
 
     struct PipelineCreateInfo;
+    struct PipelineLinkInfo;
     struct QueueCreateInfo;
 
     struct DeviceCreateInfo {
         Instance& instance;
 
         std::vector<QueueCreateInfo> queues;
+
+        Flags requestedFeatures = DeviceFeatureFlags::NONE;
+    };
+
+    struct DeviceFunctionTable {
+        PFN_vkCmdSetCullModeEXT cmdSetCullMode = nullptr;
+        PFN_vkCmdSetFrontFaceEXT cmdSetFrontFace = nullptr;
+        PFN_vkCmdSetPrimitiveTopologyEXT cmdSetPrimitiveTopology = nullptr;
+        PFN_vkCmdSetDepthTestEnableEXT cmdSetDepthTestEnable = nullptr;
+        PFN_vkCmdSetDepthWriteEnableEXT cmdSetDepthWriteEnable = nullptr;
+        PFN_vkCmdSetDepthCompareOpEXT cmdSetDepthCompareOp = nullptr;
+        PFN_vkCmdSetDepthBoundsTestEnableEXT cmdSetDepthBoundsTestEnable = nullptr;
+        PFN_vkCmdSetStencilTestEnableEXT cmdSetStencilTestEnable = nullptr;
+        PFN_vkCmdSetStencilOpEXT cmdSetStencilOp = nullptr;
+        PFN_vkCmdSetDepthBiasEnableEXT cmdSetDepthBiasEnable = nullptr;
+        PFN_vkCmdSetPrimitiveRestartEnableEXT cmdSetPrimitiveRestartEnable = nullptr;
+        PFN_vkCmdSetRasterizerDiscardEnableEXT cmdSetRasterizerDiscardEnable = nullptr;
+        PFN_vkCmdSetDepthClampEnableEXT cmdSetDepthClampEnable = nullptr;
+        PFN_vkCmdSetColorBlendEnableEXT cmdSetColorBlendEnable = nullptr;
+        PFN_vkCmdSetColorWriteMaskEXT cmdSetColorWriteMask = nullptr;
+        PFN_vkCmdSetAlphaToCoverageEnableEXT cmdSetAlphaToCoverageEnable = nullptr;
+        PFN_vkCmdPipelineBarrier2KHR cmdPipelineBarrier2 = nullptr;
+        PFN_vkCmdBeginRenderingKHR cmdBeginRendering = nullptr;
+        PFN_vkCmdEndRenderingKHR cmdEndRendering = nullptr;
+        PFN_vkWaitForPresentKHR waitForPresent = nullptr;
+        PFN_vkGetBufferDeviceAddressKHR getBufferDeviceAddress = nullptr;
+    };
+
+    struct MemoryHeapBudget {
+        std::uint32_t heapIndex;
+        std::uint64_t usageBytes;
+        std::uint64_t budgetBytes;
+        std::uint64_t allocatedBytes;
+
+        bool isDeviceLocal;
     };
 
+    using MemoryPressureCallback = std::function<void(const MemoryHeapBudget& budget, float threshold)>;
+
     class Device {
     public:
         void create(const DeviceCreateInfo& createInfo);
@@ -35,17 +88,80 @@ namespace vulkanite::renderer {
         bool waitForFences(const std::vector<Fence>& fences, bool waitAll = true, std::uint32_t timeout = std::numeric_limits<std::uint32_t>::max());
         bool resetFences(const std::vector<Fence>& fences);
 
+        Fence acquireFence();
+        bool recycleFences(std::vector<Fence>& fences);
+        Semaphore acquireSemaphore();
+        void releaseSemaphores(std::vector<Semaphore>& semaphores);
+        void releaseSemaphoresAfter(std::vector<Semaphore>& semaphores, const Fence& fence);
+
         std::vector<Pipeline> createPipelines(const std::vector<PipelineCreateInfo>& createInfos);
+        std::vector<Pipeline> linkPipelines(const std::vector<PipelineLinkInfo>& linkInfos);
         std::span<Queue> getQueues();
+        CommandPool& getThreadCommandPool(Queue& queue);
+
+        // must be called by a thread before it exits, since its id may be reused by a later thread that would inherit the pools
+        void releaseThreadCommandPools();
+        Flags getEnabledFeatures() const;
+        bool supportsDeviceLocalHostVisibleMemory() const;
+
+        std::vector<MemoryHeapBudget> getMemoryBudget() const;
+        void updateMemoryBudget();
+        std::uint32_t addMemoryPressureCallback(float threshold, MemoryPressureCallback callback);
+        void removeMemoryPressureCallback(std::uint32_t callbackId);
 
     private:
+        struct MemoryPressureHandler {
+            std::uint32_t id;
+            float threshold;
+
+            MemoryPressureCallback callback;
+
+            std::vector<bool> triggered;
+        };
+
+        struct PendingSemaphores {
+            VkFence fence;
+
+            std::vector<VkSemaphore> semaphores;
+        };
+
         VkDevice device_ = nullptr;
         VmaAllocator allocator_ = nullptr;
         Instance* instance_ = nullptr;
 
         std::vector<Queue> queues_;
 
+        Flags enabledFeatures_ = DeviceFeatureFlags::NONE;
+        DeviceFunctionTable functions_;
+
+        // queues sharing a stripe serialise submits, distinct VkQueues rarely collide
+        std::array<std::mutex, 8> queueMutexes_;
+
+        std::mutex threadCommandPoolMutex_;
+        std::map<std::pair<std::thread::id, std::uint32_t>, std::unique_ptr<CommandPool>> threadCommandPools_;
+
+        std::mutex framebufferCacheMutex_;
+        std::vector<FramebufferCache*> framebufferCaches_;
+
+        std::mutex synchronisationPoolMutex_;
+        std::vector<VkFence> freeFences_;
+        std::vector<VkSemaphore> freeSemaphores_;
+        std::vector<PendingSemaphores> pendingSemaphores_;
+
+        std::mutex memoryPressureMutex_;
+        std::vector<MemoryPressureHandler> memoryPressureHandlers_;
+
+        std::uint32_t nextMemoryPressureHandlerId_ = 0;
+        std::atomic<std::uint32_t> budgetFrameIndex_ = 0;
+
+        void loadFunctions();
+        void collectSignalledSemaphores();
+        void releasePendingSemaphores(VkFence fence);
+        void forgetFence(VkFence fence);
+        bool isSemaphorePooled(VkSemaphore semaphore) const;
+
         friend class CommandPool;
+        friend class CommandBuffer;
         friend class Buffer;
         friend class ShaderModule;
         friend class Semaphore;
@@ -60,6 +176,10 @@ namespace vulkanite::renderer {
         friend class Image;
         friend class RenderPass;
         friend class Swapchain;
+        friend class FrameGraph;
+        friend class FramebufferCache;
+        friend class MemoryPool;
+        friend class Defragmenter;
     };
 }
 
@@ -0,0 +1,179 @@
+#pragma once
+
+#include "../macros/cppstd.hpp"
+
+#if VULKANITE_SUPPORTED
+
+#include "configuration.hpp"
+
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <vk_mem_alloc.h>
+#include <vulkan/vulkan.h>
+
+namespace vulkanite::renderer {
+    class Device;
+    class Image;
+    class CommandBuffer;
+
+    using FrameGraphResource = std::uint32_t;
+
+    struct FrameGraphCreateInfo {
+        Device& device;
+
+        // zero picks one less than the hardware concurrency; execute() always records on the calling thread too
+        std::uint32_t workerThreadCount = 0;
+
+        // transients released by reset() or a recompile are destroyed only once this many later frames have been
+        // executed, so execute() must not record frame N before the GPU has finished frame N - framesInFlight
+        std::uint32_t framesInFlight = 2;
+    };
+
+    struct FrameGraphImageInfo {
+        ImageType type;
+        ImageFormat format;
+        MemoryType memoryType;
+        Flags usageFlags;
+
+        glm::uvec3 extent;
+
+        std::uint32_t sampleCount;
+        std::uint32_t mipLevels;
+        std::uint32_t arrayLayers;
+    };
+
+    struct FrameGraphResourceAccess {
+        FrameGraphResource resource;
+        ImageUsage usage;
+    };
+
+    struct FrameGraphPassInfo {
+        std::vector<FrameGraphResourceAccess> reads;
+        std::vector<FrameGraphResourceAccess> writes;
+
+        // invoked from the frame graph's worker threads, concurrently with the callbacks of passes recorded into other command pools
+        std::function<void(CommandBuffer&)> record;
+
+        bool hasSideEffects = false;
+    };
+
+    class FrameGraph {
+    public:
+        void create(const FrameGraphCreateInfo& createInfo);
+        // the device must be idle, transients still awaiting their frames are destroyed immediately
+        void destroy();
+
+        FrameGraphResource importImage(Image& image);
+        FrameGraphResource createImage(const FrameGraphImageInfo& imageInfo);
+        std::uint32_t addPass(const FrameGraphPassInfo& passInfo);
+        void markOutput(FrameGraphResource resource, ImageUsage finalUsage);
+
+        void compile();
+        // passes whose command buffers share a command pool are recorded one after another on a single thread,
+        // allocate each buffer from its own pool (one per worker is enough) to record passes in parallel
+        bool execute(std::vector<CommandBuffer>& commandBuffers);
+        void reset();
+
+        const std::vector<std::uint32_t>& getSchedule() const;
+        std::uint32_t getLevelCount() const;
+        bool isPassCulled(std::uint32_t pass) const;
+        Image& getImage(FrameGraphResource resource);
+        std::uint64_t getTransientMemorySize() const;
+
+    private:
+        struct Pass {
+            FrameGraphPassInfo info;
+
+            std::uint32_t level = 0;
+
+            bool culled = false;
+        };
+
+        struct Resource {
+            Image* image = nullptr;
+
+            std::optional<ImageUsage> finalUsage;
+            std::optional<FrameGraphImageInfo> transientInfo;
+            std::unique_ptr<Image> transientImage;
+
+            std::uint32_t firstLevel = 0;
+            std::uint32_t lastLevel = 0;
+
+            std::optional<FrameGraphResource> aliasPredecessor;
+        };
+
+        struct TransientBlock {
+            MemoryType memoryType;
+            VkMemoryRequirements requirements;
+
+            std::vector<FrameGraphResource> resources;
+        };
+
+        struct RetiredTransients {
+            std::uint64_t frame;
+
+            std::vector<VkImage> images;
+            std::vector<VmaAllocation> allocations;
+        };
+
+        struct WorkerPool {
+            std::vector<std::thread> threads;
+
+            std::mutex mutex;
+            std::condition_variable wake;
+            std::condition_variable idle;
+
+            std::function<void()> task;
+            std::exception_ptr error;
+
+            std::uint64_t generation = 0;
+            std::uint64_t pending = 0;
+
+            bool stopping = false;
+        };
+
+        std::vector<Pass> passes_;
+        std::vector<Resource> resources_;
+        std::vector<std::uint32_t> schedule_;
+        std::vector<VmaAllocation> transientAllocations_;
+        std::vector<RetiredTransients> retiredTransients_;
+
+        std::uint32_t levelCount_ = 0;
+        std::uint64_t transientMemorySize_ = 0;
+        std::uint64_t frameIndex_ = 0;
+        std::uint32_t framesInFlight_ = 2;
+
+        bool compiled_ = false;
+
+        Device* device_ = nullptr;
+
+        std::unique_ptr<WorkerPool> workerPool_;
+
+        void startWorkers(std::uint32_t workerCount);
+        void stopWorkers();
+        void runOnWorkers(const std::function<void()>& task);
+
+        void cullPasses();
+        void schedulePasses();
+        void allocateTransients();
+        void releaseTransients();
+        void destroyRetiredTransients(bool waitedIdle);
+
+        static bool conflicts(const Pass& first, const Pass& second);
+        static void workerLoop(WorkerPool& pool);
+    };
+}
+
+#include "detail/frame_graph.inl"
+
+#endif
\ No newline at end of file
@@ -4,6 +4,9 @@
 
 #if VULKANITE_SUPPORTED
 
+#include <cstdint>
+#include <map>
+#include <mutex>
 #include <vector>
 
 #include <vulkan/vulkan.h>
@@ -30,6 +33,31 @@ namespace vulkanite::renderer {
         Device* device_ = nullptr;
 
         friend class CommandBuffer;
+        friend class FramebufferCache;
+    };
+
+    struct FramebufferCacheCreateInfo {
+        Device& device;
+    };
+
+    class FramebufferCache {
+    public:
+        void create(const FramebufferCacheCreateInfo& createInfo);
+        void destroy();
+
+        Framebuffer getFramebuffer(RenderPass& renderPass, const std::vector<ImageView>& imageViews);
+        std::uint32_t getFramebufferCount() const;
+
+    private:
+        std::map<std::vector<std::uint64_t>, Framebuffer> framebuffers_;
+        mutable std::mutex mutex_;
+
+        Device* device_ = nullptr;
+
+        void evict(std::uint64_t handle);
+
+        friend class ImageView;
+        friend class RenderPass;
     };
 }
 
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "../macros/cppstd.hpp"
+
+#if VULKANITE_SUPPORTED
+
+#include "buffer.hpp"
+#include "configuration.hpp"
+#include "range_allocator.hpp"
+
+#include <cstdint>
+#include <optional>
+
+#include <vulkan/vulkan.h>
+
+namespace vulkanite::renderer {
+    class Device;
+    class CommandBuffer;
+
+    struct GeometryPoolCreateInfo {
+        Device& device;
+        IndexType indexType;
+
+        std::uint32_t vertexStride;
+        std::uint32_t vertexCapacity;
+        std::uint32_t indexCapacity;
+
+        Flags usageFlags = BufferUsageFlags::NONE;
+    };
+
+    struct GeometryAllocation {
+        std::uint32_t firstVertex;
+        std::uint32_t vertexCount;
+        std::uint32_t firstIndex;
+        std::uint32_t indexCount;
+
+        std::int32_t vertexOffset;
+
+        std::uint64_t vertexOffsetBytes;
+        std::uint64_t indexOffsetBytes;
+    };
+
+    class GeometryPool {
+    public:
+        void create(const GeometryPoolCreateInfo& createInfo);
+        void destroy();
+
+        std::optional<GeometryAllocation> allocate(std::uint32_t vertexCount, std::uint32_t indexCount);
+        // throws if the allocation is not currently live in this pool
+        void free(const GeometryAllocation& allocation);
+
+        void bind(CommandBuffer& commandBuffer);
+
+        Buffer& getVertexBuffer();
+        Buffer& getIndexBuffer();
+        IndexType getIndexType() const;
+        std::uint32_t getVertexStride() const;
+        std::uint32_t getUsedVertexCount() const;
+        std::uint32_t getUsedIndexCount() const;
+        std::uint32_t getLargestFreeVertexRange() const;
+        std::uint32_t getLargestFreeIndexRange() const;
+
+        explicit operator bool() {
+            return vertexBuffer_ && indexBuffer_;
+        }
+
+    private:
+        Buffer vertexBuffer_;
+        Buffer indexBuffer_;
+
+        IndexType indexType_ = IndexType::UINT32;
+
+        std::uint32_t vertexStride_ = 0;
+        std::uint32_t indexSize_ = 0;
+
+        RangeAllocator vertexRanges_;
+        RangeAllocator indexRanges_;
+    };
+}
+
+#include "detail/geometry_pool.inl"
+
+#endif
\ No newline at end of file
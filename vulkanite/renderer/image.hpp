@@ -7,7 +7,9 @@
 #include "configuration.hpp"
 
 #include <cstdint>
+#include <memory>
 #include <span>
+#include <vector>
 
 #include <glm/glm.hpp>
 
@@ -18,6 +20,7 @@ namespace vulkanite::renderer {
     class Queue;
     class Device;
     class Instance;
+    class MemoryPool;
 
     struct ImageCreateInfo {
         Device& device;
@@ -31,6 +34,20 @@ namespace vulkanite::renderer {
         std::uint32_t sampleCount;
         std::uint32_t mipLevels;
         std::uint32_t arrayLayers;
+
+        MemoryPool* pool = nullptr;
+
+        bool dedicatedAllocation = false;
+
+        // ignored when allocated from a pool, which applies its own priority
+        float priority = 0.5f;
+    };
+
+    struct ImageSubresourceRange {
+        std::uint32_t baseMipLevel;
+        std::uint32_t mipLevelCount;
+        std::uint32_t baseArrayLayer;
+        std::uint32_t arrayLayerCount;
     };
 
     struct ImageMapping {
@@ -57,8 +74,21 @@ namespace vulkanite::renderer {
         std::uint32_t getSampleCount() const;
         std::uint32_t getMipLevels() const;
         std::uint32_t getArrayLayers() const;
+        ImageLayout getLayout(std::uint32_t mipLevel, std::uint32_t arrayLayer) const;
 
     private:
+        struct SubresourceState {
+            VkImageLayout layout = VK_IMAGE_LAYOUT_UNDEFINED;
+            VkPipelineStageFlags stages = 0;
+            VkAccessFlags access = 0;
+        };
+
+        struct UsageState {
+            VkImageLayout layout;
+            VkPipelineStageFlags stages;
+            VkAccessFlags access;
+        };
+
         VkImage image_ = nullptr;
         VmaAllocation allocation_ = nullptr;
         Device* device_ = nullptr;
@@ -77,17 +107,32 @@ namespace vulkanite::renderer {
 
         std::uint64_t size_ = 0;
 
+        VkImageUsageFlags usage_ = 0;
+
+        std::shared_ptr<std::vector<SubresourceState>> subresourceStates_;
+
+        void initialiseSubresourceStates(VkPipelineStageFlags stages);
+        bool containsRange(const ImageSubresourceRange& range) const;
+
         static VkFormat mapFormat(ImageFormat format, renderer::Instance& instance);
         static ImageFormat reverseMapFormat(VkFormat format);
 
         static VkImageType mapType(ImageType type);
         static ImageType reverseMapType(VkImageType type);
 
+        static VkImageLayout mapLayout(ImageLayout layout);
+        static ImageLayout reverseMapLayout(VkImageLayout layout);
+        static UsageState mapUsage(ImageUsage usage);
+        static VkImageAspectFlags getAspectMask(VkFormat format);
+
+        friend class Device;
         friend class Swapchain;
         friend class RenderPass;
         friend class Framebuffer;
         friend class ImageView;
         friend class CommandBuffer;
+        friend class FrameGraph;
+        friend class Defragmenter;
     };
 
     struct BufferImageCopyRegion {
@@ -9,6 +9,7 @@
 #include <glm/glm.hpp>
 
 namespace vulkanite::renderer {
+    class Device;
     class Image;
     class Queue;
 
@@ -36,9 +37,10 @@ namespace vulkanite::renderer {
 
     private:
         VkImage image_ = nullptr;
-        VkDevice device_ = nullptr;
+        Device* device_ = nullptr;
         VkImageView imageView_ = nullptr;
         VkImageViewType imageViewType_ = VK_IMAGE_VIEW_TYPE_MAX_ENUM;
+        VkFormat format_ = VK_FORMAT_UNDEFINED;
 
         glm::uvec3 extent_;
 
@@ -52,6 +54,8 @@ namespace vulkanite::renderer {
 
         friend class Framebuffer;
         friend class DescriptorPool;
+        friend class CommandBuffer;
+        friend class FramebufferCache;
     };
 
     struct ImageMemoryBarrier {
@@ -71,6 +75,26 @@ namespace vulkanite::renderer {
         Flags sourceAccessFlags;
         Flags destinationAccessFlags;
     };
+
+    struct ImageMemoryBarrier2 {
+        Image& image;
+        Queue* sourceQueue;
+        Queue* destinationQueue;
+
+        std::uint32_t baseMipLevel;
+        std::uint32_t mipLevelCount;
+        std::uint32_t baseArrayLayer;
+        std::uint32_t arrayLayerCount;
+
+        ImageLayout oldLayout;
+        ImageLayout newLayout;
+
+        Flags aspectMask;
+        Flags64 sourceStageFlags;
+        Flags64 sourceAccessFlags;
+        Flags64 destinationStageFlags;
+        Flags64 destinationAccessFlags;
+    };
 }
 
 #include "detail/image_view.inl"
@@ -35,6 +35,9 @@ namespace vulkanite::renderer {
 
         std::uint32_t apiVersion_ = 0;
 
+        bool supportsSurfaceMaintenance_ = false;
+        bool supportsLargeHostVisibleHeap_ = false;
+
         std::vector<VkQueueFamilyProperties> queueFamilyProperties_;
         std::vector<std::uint32_t> queueFamilyOccupations_;
 
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "../macros/cppstd.hpp"
+
+#if VULKANITE_SUPPORTED
+
+#include "pipeline.hpp"
+#include "shader_reflection.hpp"
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <vector>
+
+#include <vulkan/vulkan.h>
+
+namespace vulkanite::renderer {
+    class Device;
+
+    struct LayoutCacheCreateInfo {
+        Device& device;
+    };
+
+    struct ReflectedPipelineLayout {
+        PipelineLayout layout;
+
+        std::vector<DescriptorSetLayout> setLayouts;
+        std::vector<PushConstantInputInfo> pushConstants;
+    };
+
+    class LayoutCache {
+    public:
+        void create(const LayoutCacheCreateInfo& createInfo);
+        void destroy();
+
+        ReflectedPipelineLayout getPipelineLayout(const std::vector<ShaderReflection>& reflections);
+        DescriptorSetLayout getDescriptorSetLayout(const std::vector<DescriptorSetInputInfo>& inputs);
+
+        std::uint32_t getDescriptorSetLayoutCount();
+        std::uint32_t getPipelineLayoutCount();
+
+    private:
+        std::map<std::vector<std::uint64_t>, DescriptorSetLayout> setLayouts_;
+        std::map<std::vector<std::uint64_t>, ReflectedPipelineLayout> pipelineLayouts_;
+        std::mutex mutex_;
+
+        Device* device_ = nullptr;
+
+        DescriptorSetLayout findDescriptorSetLayout(const std::vector<DescriptorSetInputInfo>& inputs);
+
+        static std::vector<std::uint64_t> serialise(const std::vector<DescriptorSetInputInfo>& inputs);
+    };
+}
+
+#include "detail/layout_cache.inl"
+
+#endif
\ No newline at end of file
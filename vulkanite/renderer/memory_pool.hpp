@@ -0,0 +1,74 @@
+#pragma once
+
+#include "../macros/cppstd.hpp"
+
+#if VULKANITE_SUPPORTED
+
+#include "configuration.hpp"
+
+#include <cstdint>
+
+#include <vk_mem_alloc.h>
+#include <vulkan/vulkan.h>
+
+namespace vulkanite::renderer {
+    class Device;
+
+    enum class MemoryPoolAlgorithm {
+        GENERAL,
+        LINEAR,
+    };
+
+    enum class MemoryPoolResourceType {
+        BUFFER,
+        IMAGE,
+    };
+
+    struct MemoryPoolCreateInfo {
+        Device& device;
+        MemoryType memoryType;
+        MemoryPoolResourceType resourceType;
+        MemoryPoolAlgorithm algorithm;
+        Flags usageFlags;
+
+        std::uint64_t blockSizeBytes = 0;
+        std::uint32_t minBlockCount = 0;
+        std::uint32_t maxBlockCount = 0;
+
+        // applies to every allocation in the pool, overriding the priority of the resources placed in it
+        float priority = 0.5f;
+    };
+
+    class MemoryPool {
+    public:
+        void create(const MemoryPoolCreateInfo& createInfo);
+        void destroy();
+
+        MemoryType getMemoryType() const;
+        MemoryPoolAlgorithm getAlgorithm() const;
+        std::uint32_t getAllocationCount() const;
+        std::uint64_t getAllocatedBytes() const;
+        std::uint64_t getReservedBytes() const;
+
+        explicit operator bool() const {
+            return pool_ && device_;
+        }
+
+    private:
+        VmaPool pool_ = nullptr;
+        Device* device_ = nullptr;
+
+        MemoryType memoryType_ = MemoryType::DEVICE_LOCAL;
+        MemoryPoolAlgorithm algorithm_ = MemoryPoolAlgorithm::GENERAL;
+
+        VmaStatistics getStatistics() const;
+
+        friend class Buffer;
+        friend class Image;
+        friend class Defragmenter;
+    };
+}
+
+#include "detail/memory_pool.inl"
+
+#endif
\ No newline at end of file
@@ -7,6 +7,10 @@
 #include "configuration.hpp"
 
 #include <cstdint>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -22,9 +26,20 @@ namespace vulkanite::renderer {
     class ImageView;
     class Sampler;
 
+    struct SpecialisationConstantEntry {
+        std::uint32_t constantID;
+        std::uint32_t offsetBytes;
+        std::uint64_t sizeBytes;
+    };
+
     struct ShaderStageInfo {
         ShaderModule& module;
         ShaderStage stage;
+
+        std::string entryPoint = "main";
+
+        std::vector<SpecialisationConstantEntry> specialisationConstants;
+        std::vector<std::uint8_t> specialisationData;
     };
 
     struct VertexInputBindingDescription {
@@ -100,6 +115,8 @@ namespace vulkanite::renderer {
     struct ColourBlendAttachment {
         bool blendEnable = false;
 
+        Flags colourWriteMask = ColourComponentFlags::ALL;
+
         BlendFactor sourceColourBlendFactor;
         BlendFactor destinationColourBlendFactor;
         BlendOperation colourBlendOperation;
@@ -138,6 +155,7 @@ namespace vulkanite::renderer {
         friend class DescriptorSet;
         friend class DescriptorPool;
         friend class PipelineLayout;
+        friend class LayoutCache;
     };
 
     struct PushConstantInputInfo {
@@ -218,6 +236,9 @@ namespace vulkanite::renderer {
     private:
         VkDescriptorPool descriptorPool_ = nullptr;
         Device* device_ = nullptr;
+
+        // held by pointer so the pool stays movable
+        std::unique_ptr<std::mutex> mutex_ = std::make_unique<std::mutex>();
     };
 
     class PipelineLayout {
@@ -231,10 +252,18 @@ namespace vulkanite::renderer {
 
         friend class Device;
         friend class CommandBuffer;
+        friend class PipelineRegistry;
+        friend class LayoutCache;
+    };
+
+    struct PipelineRenderingInfo {
+        std::vector<ImageFormat> colourFormats;
+
+        std::optional<ImageFormat> depthStencilFormat;
     };
 
     struct PipelineCreateInfo {
-        RenderPass& renderPass;
+        RenderPass* renderPass;
         PipelineLayout& layout;
 
         std::vector<ShaderStageInfo> shaderStages;
@@ -248,16 +277,26 @@ namespace vulkanite::renderer {
         RasterisationState rasterisation;
         MultisampleState multisample;
         ColourBlendState colourBlend;
+        PipelineRenderingInfo rendering;
+
+        Flags dynamicStateFlags = DynamicStateFlags::NONE;
+        Flags libraryFlags = PipelineLibraryFlags::NONE;
     };
 
     class Pipeline {
     public:
         void destroy();
 
+        Flags getDynamicStateFlags() const;
+        Flags getLibraryFlags() const;
+
     private:
         VkPipeline pipeline_ = nullptr;
         Device* device_ = nullptr;
 
+        Flags dynamicStateFlags_ = DynamicStateFlags::NONE;
+        Flags libraryFlags_ = PipelineLibraryFlags::NONE;
+
         static VkShaderStageFlagBits reverseMapShaderStage(ShaderStage stage);
         static VkVertexInputRate reverseMapVertexInputRate(VertexInputRate rate);
         static VkPrimitiveTopology reverseMapPrimitive(PolygonTopology topology);
@@ -273,6 +312,39 @@ namespace vulkanite::renderer {
 
         friend class Device;
         friend class CommandBuffer;
+        friend class LinkedPipeline;
+    };
+
+    struct PipelineLinkInfo {
+        PipelineLayout& layout;
+
+        std::vector<Pipeline> libraries;
+
+        bool optimise = false;
+    };
+
+    struct LinkedPipelineCreateInfo {
+        Device& device;
+        PipelineLayout& layout;
+
+        std::vector<Pipeline> libraries;
+    };
+
+    class LinkedPipeline {
+    public:
+        void create(const LinkedPipelineCreateInfo& createInfo);
+        void destroy();
+
+        Pipeline& getPipeline();
+        bool isOptimised() const;
+
+    private:
+        Pipeline fastPipeline_;
+        Pipeline optimisedPipeline_;
+
+        std::future<std::vector<Pipeline>> optimisation_;
+
+        bool optimised_ = false;
     };
 }
 
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "../macros/cppstd.hpp"
+
+#if VULKANITE_SUPPORTED
+
+#include "pipeline.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <vulkan/vulkan.h>
+
+namespace vulkanite::renderer {
+    class Device;
+
+    struct PipelineRegistryCreateInfo {
+        Device& device;
+
+        // fixed for the registry's lifetime; getPipeline() throws once every slot is taken rather than growing
+        std::uint32_t capacity = 4096;
+    };
+
+    class PipelineRegistry {
+    public:
+        void create(const PipelineRegistryCreateInfo& createInfo);
+        void destroy();
+
+        // the registry owns the returned pipeline and destroys it in destroy(), callers must not destroy it themselves
+        const Pipeline& getPipeline(const PipelineCreateInfo& createInfo);
+        std::uint32_t getPipelineCount() const;
+
+    private:
+        enum class EntryState : std::uint32_t {
+            PENDING,
+            READY,
+            FAILED,
+        };
+
+        struct Entry {
+            std::uint64_t hash = 0;
+            std::vector<std::uint64_t> key;
+
+            Pipeline pipeline;
+
+            std::atomic<EntryState> state = EntryState::PENDING;
+        };
+
+        std::unique_ptr<std::atomic<Entry*>[]> slots_;
+        std::atomic<std::uint32_t> pipelineCount_ = 0;
+        std::uint32_t capacity_ = 0;
+
+        Device* device_ = nullptr;
+
+        const Pipeline failedPipeline_ = {};
+
+        const Pipeline& buildEntry(Entry& entry, const PipelineCreateInfo& createInfo);
+
+        static std::vector<std::uint64_t> serialise(const PipelineCreateInfo& createInfo);
+        static std::uint64_t hash(const std::vector<std::uint64_t>& key);
+    };
+}
+
+#include "detail/pipeline_registry.inl"
+
+#endif
\ No newline at end of file
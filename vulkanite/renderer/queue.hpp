@@ -5,6 +5,7 @@
 #if VULKANITE_SUPPORTED
 
 #include <cstdint>
+#include <mutex>
 #include <vector>
 
 #include <vulkan/vulkan.h>
@@ -41,6 +42,8 @@ namespace vulkanite::renderer {
         std::uint32_t familyIndex_;
         std::uint32_t queueIndex_;
 
+        std::mutex* mutex_ = nullptr;
+
         friend class Device;
         friend class CommandPool;
         friend class CommandBuffer;
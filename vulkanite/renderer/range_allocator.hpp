@@ -0,0 +1,40 @@
+#pragma once
+
+#include "../macros/cppstd.hpp"
+
+#if VULKANITE_SUPPORTED
+
+#include <cstdint>
+#include <map>
+#include <optional>
+
+namespace vulkanite::renderer {
+    // best-fit allocator over [0, capacity) that coalesces neighbouring ranges on release
+    class RangeAllocator {
+    public:
+        void create(std::uint32_t capacity);
+        void destroy();
+
+        std::optional<std::uint32_t> allocate(std::uint32_t count);
+        void free(std::uint32_t first, std::uint32_t count);
+
+        // true if the range lies inside the capacity and is currently allocated
+        bool isAllocated(std::uint32_t first, std::uint32_t count) const;
+
+        std::uint32_t getCapacity() const;
+        std::uint32_t getUsedCount() const;
+        std::uint32_t getLargestFreeRange() const;
+        std::uint32_t getFreeRangeCount() const;
+
+    private:
+        // free ranges keyed by first element so neighbours can be coalesced on release
+        std::map<std::uint32_t, std::uint32_t> freeRanges_;
+
+        std::uint32_t capacity_ = 0;
+        std::uint32_t usedCount_ = 0;
+    };
+}
+
+#include "detail/range_allocator.inl"
+
+#endif
\ No newline at end of file
@@ -16,6 +16,7 @@
 namespace vulkanite::renderer {
     class Framebuffer;
     class Device;
+    class ImageView;
 
     struct FrameAttachmentOperationInfo {
         LoadOperation load;
@@ -78,6 +79,7 @@ namespace vulkanite::renderer {
         friend class CommandBuffer;
         friend class Device;
         friend class Framebuffer;
+        friend class PipelineRegistry;
     };
 
     struct RenderPassRegion {
@@ -96,6 +98,34 @@ namespace vulkanite::renderer {
         std::optional<float> depthClearValue;
         std::optional<std::uint32_t> stencilClearValue;
     };
+
+    struct RenderingColourAttachmentInfo {
+        ImageView& imageView;
+        ImageLayout layout;
+        FrameAttachmentOperationInfo operations;
+
+        glm::fvec4 clearValue = {};
+    };
+
+    struct RenderingDepthStencilAttachmentInfo {
+        ImageView& imageView;
+        ImageLayout layout;
+        FrameAttachmentOperationInfo depthOperations;
+        FrameAttachmentOperationInfo stencilOperations;
+
+        float depthClearValue = 1.0;
+        std::uint32_t stencilClearValue = 0;
+    };
+
+    struct RenderingBeginInfo {
+        RenderPassRegion region;
+
+        std::vector<RenderingColourAttachmentInfo> colourAttachments;
+
+        std::optional<RenderingDepthStencilAttachmentInfo> depthStencilAttachment;
+
+        std::uint32_t layerCount = 1;
+    };
 }
 
 #include "detail/render_pass.inl"
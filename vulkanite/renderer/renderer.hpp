@@ -14,17 +14,25 @@
 #include "command_buffer.hpp"
 #include "command_pool.hpp"
 #include "configuration.hpp"
+#include "defragmenter.hpp"
 #include "fence.hpp"
+#include "frame_graph.hpp"
 #include "framebuffer.hpp"
+#include "geometry_pool.hpp"
 #include "image.hpp"
 #include "image_view.hpp"
 #include "instance.hpp"
+#include "layout_cache.hpp"
+#include "memory_pool.hpp"
 #include "pipeline.hpp"
+#include "pipeline_registry.hpp"
+#include "range_allocator.hpp"
 #include "queue.hpp"
 #include "render_pass.hpp"
 #include "sampler.hpp"
 #include "semaphore.hpp"
 #include "shader_module.hpp"
+#include "shader_reflection.hpp"
 #include "surface.hpp"
 #include "swapchain.hpp"
 
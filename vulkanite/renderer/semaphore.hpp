@@ -18,6 +18,7 @@ namespace vulkanite::renderer {
         VkSemaphore semaphore_ = nullptr;
         Device* device_ = nullptr;
 
+        friend class Device;
         friend class Queue;
         friend class Swapchain;
     };
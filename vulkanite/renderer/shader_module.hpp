@@ -4,8 +4,11 @@
 
 #if VULKANITE_SUPPORTED
 
+#include "shader_reflection.hpp"
+
 #include <cstdint>
 #include <span>
+#include <string>
 
 #include <vulkan/vulkan.h>
 
@@ -16,6 +19,11 @@ namespace vulkanite::renderer {
         Device& device;
 
         std::span<std::uint32_t> data;
+
+        bool reflect = false;
+
+        // entry point to reflect, may be left empty when the module has only one
+        std::string entryPoint = {};
     };
 
     class ShaderModule {
@@ -23,11 +31,16 @@ namespace vulkanite::renderer {
         void create(const ShaderModuleCreateInfo& createInfo);
         void destroy();
 
+        const ShaderReflection& getReflection() const;
+
     private:
         VkShaderModule module_ = nullptr;
         Device* device_ = nullptr;
 
+        ShaderReflection reflection_ = {};
+
         friend class Device;
+        friend class PipelineRegistry;
     };
 }
 
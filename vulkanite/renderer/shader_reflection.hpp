@@ -0,0 +1,110 @@
+#pragma once
+
+#include "../macros/cppstd.hpp"
+
+#if VULKANITE_SUPPORTED
+
+#include "configuration.hpp"
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+namespace vulkanite::renderer {
+    struct ShaderResourceBinding {
+        DescriptorInputType type;
+        Flags stageFlags;
+
+        std::uint32_t set;
+        std::uint32_t binding;
+        std::uint32_t count;
+    };
+
+    struct ShaderVertexInput {
+        VertexAttributeFormat format;
+
+        std::uint32_t location;
+    };
+
+    struct ShaderReflection {
+        ShaderStage stage;
+
+        std::string entryPoint;
+
+        std::vector<ShaderResourceBinding> bindings;
+        std::vector<ShaderVertexInput> vertexInputs;
+
+        std::uint32_t pushConstantSizeBytes = 0;
+
+        glm::uvec3 workgroupSize = {0, 0, 0};
+
+        // an empty entry point name selects the module's only entry point; modules with several must name one
+        static ShaderReflection reflect(std::span<const std::uint32_t> code, std::string_view entryPoint = {});
+    };
+
+    class ShaderReflector {
+    private:
+        struct Type {
+            std::uint32_t opcode = 0;
+            std::vector<std::uint32_t> operands;
+        };
+
+        struct Decorations {
+            std::uint32_t set = 0;
+            std::uint32_t binding = 0;
+            std::uint32_t location = 0;
+            std::uint32_t arrayStride = 0;
+
+            bool hasBinding = false;
+            bool hasLocation = false;
+            bool builtIn = false;
+            bool block = false;
+            bool bufferBlock = false;
+        };
+
+        struct MemberDecorations {
+            std::uint32_t offset = 0;
+            std::uint32_t matrixStride = 0;
+        };
+
+        struct Variable {
+            std::uint32_t id;
+            std::uint32_t pointerType;
+            std::uint32_t storageClass;
+        };
+
+        std::unordered_map<std::uint32_t, Type> types_;
+        std::unordered_map<std::uint32_t, std::uint32_t> constants_;
+        std::unordered_map<std::uint32_t, Decorations> decorations_;
+        std::unordered_map<std::uint32_t, std::vector<MemberDecorations>> memberDecorations_;
+        std::vector<Variable> variables_;
+        std::vector<std::uint32_t> interface_;
+
+        void parse(std::span<const std::uint32_t> code, std::string_view entryPoint, ShaderReflection& reflection);
+        void reflectVariables(ShaderReflection& reflection);
+
+        std::uint64_t getTypeSize(std::uint32_t typeID);
+        std::uint64_t getMemberSize(std::uint32_t structID, std::uint32_t member);
+        std::uint32_t getElementCount(std::uint32_t& typeID);
+
+        const Type& getType(std::uint32_t typeID) const;
+        std::uint32_t getConstant(std::uint32_t constantID) const;
+        const Decorations& getDecorations(std::uint32_t id) const;
+        const std::vector<MemberDecorations>& getMemberDecorations(std::uint32_t structID) const;
+
+        static Flags mapStageFlags(ShaderStage stage);
+        static VertexAttributeFormat mapVertexAttributeFormat(const Type& scalar, std::uint32_t componentCount);
+
+        friend struct ShaderReflection;
+        friend class LayoutCache;
+    };
+}
+
+#include "detail/shader_reflection.inl"
+
+#endif
\ No newline at end of file
@@ -4,7 +4,10 @@
 
 #if VULKANITE_SUPPORTED
 
+#include <chrono>
 #include <cstdint>
+#include <deque>
+#include <optional>
 #include <span>
 #include <vector>
 
@@ -23,14 +26,39 @@ namespace vulkanite::renderer {
 
     enum class ImageFormat : int;
 
+    enum class LatencyMode {
+        THROUGHPUT,
+        LOW_LATENCY,
+    };
+
+    enum class PresentMode {
+        IMMEDIATE,
+        MAILBOX,
+        FIFO,
+        FIFO_RELAXED,
+    };
+
+    enum class PresentModePolicy {
+        VSYNC,
+        ADAPTIVE,
+        UNCAPPED,
+        LOWEST_LATENCY,
+    };
+
     struct SwapchainCreateInfo {
         Surface& surface;
         Device& device;
         Queue& presentQueue;
+        // work using the old images must be submitted before create(); they are released once it completes
         Swapchain* oldSwapchain = nullptr;
 
         std::uint32_t requestedImageCount = 0;
+        std::uint32_t maxFramesInFlight = 2;
         bool shouldSynchronise = true;
+
+        LatencyMode latencyMode = LatencyMode::THROUGHPUT;
+
+        std::optional<PresentModePolicy> presentModePolicy;
     };
 
     enum class SwapchainResult {
@@ -53,6 +81,17 @@ namespace vulkanite::renderer {
         bool isSynchronised() const;
         bool shouldRecreate() const;
         glm::uvec2 getExtent() const;
+        LatencyMode getLatencyMode() const;
+        std::uint32_t getMaxFramesInFlight() const;
+        // input-to-display with PRESENT_WAIT; otherwise only input-to-submit, measured when vkQueuePresentKHR returns
+        std::chrono::nanoseconds getInputLatency() const;
+        PresentMode getPresentMode() const;
+        std::vector<PresentMode> getSupportedPresentModes() const;
+        std::optional<PresentModePolicy> getPresentModePolicy() const;
+
+        void setLatencyMode(LatencyMode mode);
+        bool setPresentModePolicy(PresentModePolicy policy);
+        void markInputSample();
 
         bool acquireNextImage(Semaphore& acquireSemaphore);
         bool presentNextImage(Semaphore& presentSemaphore);
@@ -70,6 +109,21 @@ namespace vulkanite::renderer {
         }
 
     private:
+        struct InputSample {
+            std::uint64_t presentId;
+
+            std::chrono::steady_clock::time_point time;
+        };
+
+        struct RetiredSwapchain {
+            VkSwapchainKHR swapchain = nullptr;
+
+            std::vector<ImageView> imageViews;
+
+            // signalled once every queue has finished the work submitted before retirement
+            std::vector<VkFence> fences;
+        };
+
         VkSwapchainKHR swapchain_ = nullptr;
         Instance* instance_ = nullptr;
         Surface* surface_ = nullptr;
@@ -85,15 +139,44 @@ namespace vulkanite::renderer {
 
         std::vector<Image> images_;
         std::vector<ImageView> imageViews_;
+        std::vector<RetiredSwapchain> retiredSwapchains_;
+
+        std::vector<VkPresentModeKHR> supportedPresentModes_;
+        std::vector<VkPresentModeKHR> compatiblePresentModes_;
+        std::optional<PresentModePolicy> presentModePolicy_;
+
+        std::vector<VkFence> acquireFences_;
+        std::vector<bool> acquireFencesPending_;
+        std::deque<InputSample> inputSamples_;
+        std::optional<std::chrono::steady_clock::time_point> pendingInputSample_;
+        std::chrono::nanoseconds inputLatency_ = {};
+
+        LatencyMode latencyMode_ = LatencyMode::THROUGHPUT;
+
+        std::uint32_t maxFramesInFlight_ = 2;
+        std::uint64_t frameIndex_ = 0;
+        std::uint64_t presentId_ = 0;
 
         bool synchronise_ = false;
         bool recreate_ = false;
+        bool retired_ = false;
 
         VkSurfaceCapabilitiesKHR getSurfaceCapabilities();
 
         void createImageResources();
+        void retire(Swapchain& oldSwapchain, VkSwapchainKHR oldHandle);
+        void releaseRetiredSwapchains(bool force);
+        void createPacingResources();
+        void releasePacingResources();
+        void waitForFrameSlot();
+        void recordInputLatency(std::uint64_t presentedId);
         void selectSurfaceFormat();
         void selectPresentMode();
+        void queryCompatiblePresentModes();
+
+        VkPresentModeKHR choosePresentMode(PresentModePolicy policy) const;
+
+        static PresentMode reverseMapPresentMode(VkPresentModeKHR mode);
     };
 }
 